@@ -46,6 +46,11 @@ void testApp::setup() {
 	// or use your own filename
 	//loadWarpSettings();
 	
+	// reload the quad warper and control panel settings automatically when
+	// the xml files are changed on disk, ie when pushing a new calibration
+	//watchWarpSettings();
+	//watchControlSettings();
+	
 	// load scenes
     sceneManager.add(new Circle());
     sceneManager.add(new Square());
@@ -69,6 +74,12 @@ void testApp::setup() {
 	//
 	setSceneManager(&sceneManager);
     sceneManager.setOverlapingTransitions(true);
+	
+	// the scenes fade themselves in & out in updateEnter() & updateExit(),
+	// you can also let the scene manager run the scene changes with an
+	// easing curve driven transition instead:
+	//sceneManager.setTransition(new ofxSceneTransition(ofxSceneTransition::CROSSFADE, 2000,
+	//                                                  ofxSceneTransition::SINE_IN_OUT));
 }
 
 //--------------------------------------------------------------
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#include "tests.h"
+
+#include "ofxInputRecorder.h"
+
+static const int NUM_FRAMES = 8;
+
+// record events over several frames the way ofxApp does, beginFrame() at the
+// start of each update with the input arriving between updates, then replay
+// & check each event comes back between the same updates it arrived in
+void testInputRecorder() {
+
+	ofxInputRecorder recorder;
+	std::vector<int> arrivedAfter; // updates done when each event arrived, by key
+
+	// record, a varying number of events between each update
+	CHECK(recorder.startRecording("inputRecorderTest.bin"));
+	for(int update = 0; update < NUM_FRAMES; ++update) {
+		for(int i = 0; i < update % 3; ++i) {
+			recorder.recordInput(ofxInputEvent(ofxInputEvent::KEY_PRESSED, (int) arrivedAfter.size()));
+			arrivedAfter.push_back(update);
+		}
+		recorder.beginFrame();
+	}
+	recorder.stopRecording();
+
+	// replay
+	CHECK(recorder.startReplay("inputRecorderTest.bin"));
+	ofxInputRecorder::Event event;
+	unsigned int numReplayed = 0;
+	for(int update = 0; update <= NUM_FRAMES; ++update) {
+		recorder.beginFrame();
+		while(recorder.nextEvent(event)) {
+			CHECK(event.input.key >= 0 && event.input.key < (int) arrivedAfter.size());
+			if(event.input.key >= 0 && event.input.key < (int) arrivedAfter.size()) {
+				CHECK(arrivedAfter[event.input.key] == update);
+				CHECK(event.frame == (unsigned int) update);
+			}
+			numReplayed++;
+		}
+	}
+	CHECK(numReplayed == arrivedAfter.size());
+	CHECK(recorder.isReplayDone());
+	recorder.stopReplay();
+}
@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#include "ofMain.h"
+#include "tests.h"
+
+int testFailures = 0;
+
+// runs the addon tests without a window, returns the number of failures
+int main(){
+
+	testInputRecorder();
+	testParticleRandom();
+	testParticleLOD();
+	testParticleManagerT();
+	testParticleSweep();
+
+	benchmarkParticles();
+
+	if(testFailures > 0) {
+		ofLogError("test") << testFailures << " checks failed";
+	}
+	else {
+		ofLogNotice("test") << "all tests passed";
+	}
+	return testFailures;
+}
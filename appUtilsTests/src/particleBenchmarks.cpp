@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#include "tests.h"
+
+#include "ofUtils.h"
+
+#include "ofxParticleManager.h"
+#include "ofxParticleManagerT.h"
+#include "ofxParticlePoint.h"
+#include "ofxParticleRandom.h"
+#include "ofxParticleSweep.h"
+
+static const unsigned int NUM_FRAMES = 100;
+static const float LIFESPAN = 1000000; // ms, nothing dies while timing
+
+// the same work for both managers: age & move right
+class BenchParticle : public ofxParticle {
+	public:
+		BenchParticle(float x, float y) : ofxParticle(x, y, 1, 1) {
+			setLifespan(LIFESPAN);
+		}
+		void update() {
+			updateAge();
+			x += 1;
+		}
+		void draw() {}
+};
+
+struct BenchPoint : public ofxParticlePoint {
+	BenchPoint(float x, float y) : ofxParticlePoint(x, y, 1, LIFESPAN) {}
+	inline void update() {
+		updateAge();
+		x += 1;
+	}
+};
+
+// time the update of the pointer & by value managers
+static void benchmarkManagers(unsigned int num) {
+
+	ofxParticleManager pointers;
+	ofxParticleManagerT<BenchPoint> values;
+	values.reserve(num);
+	for(unsigned int i = 0; i < num; ++i) {
+		pointers.addParticle(new BenchParticle(i % 1024, i / 1024));
+		values.addParticle(BenchPoint(i % 1024, i / 1024));
+	}
+
+	unsigned long long start = ofGetElapsedTimeMicros();
+	for(unsigned int i = 0; i < NUM_FRAMES; ++i) {
+		pointers.update();
+	}
+	float pointersMs = (ofGetElapsedTimeMicros() - start) / 1000.0f / NUM_FRAMES;
+
+	start = ofGetElapsedTimeMicros();
+	for(unsigned int i = 0; i < NUM_FRAMES; ++i) {
+		values.update();
+	}
+	float valuesMs = (ofGetElapsedTimeMicros() - start) / 1000.0f / NUM_FRAMES;
+
+	CHECK(pointers.size() == num && values.size() == num);
+	ofLogNotice("benchmark") << "update " << num << " particles: ofxParticleManager "
+		<< pointersMs << " ms, ofxParticleManagerT " << valuesMs << " ms";
+}
+
+// time finding the overlapping pairs of rects that move a little each frame
+static void benchmarkSweep(unsigned int num) {
+
+	// about 1 pair per rect
+	float area = sqrtf(num) * 16;
+	ofxParticleRandom random(7);
+	std::vector<ofRectangle> rects(num);
+	std::vector<float> vx(num), vy(num);
+	for(unsigned int i = 0; i < num; ++i) {
+		rects[i].set(random.next(area), random.next(area), 4, 4);
+		vx[i] = random.nextSigned();
+		vy[i] = random.nextSigned();
+	}
+
+	ofxParticleSweep sweep;
+	for(unsigned int i = 0; i < num; ++i) {
+		sweep.update(i, rects[i]);
+	}
+	sweep.findPairs(); // first sort from scratch
+
+	unsigned int numPairs = 0;
+	unsigned long long start = ofGetElapsedTimeMicros();
+	for(unsigned int frame = 0; frame < NUM_FRAMES; ++frame) {
+		for(unsigned int i = 0; i < num; ++i) {
+			rects[i].x += vx[i];
+			rects[i].y += vy[i];
+			sweep.update(i, rects[i]);
+		}
+		numPairs += sweep.findPairs().size();
+	}
+	float ms = (ofGetElapsedTimeMicros() - start) / 1000.0f / NUM_FRAMES;
+
+	CHECK(sweep.size() == num);
+	ofLogNotice("benchmark") << "sweep " << num << " moving rects: " << ms << " ms, "
+		<< numPairs / NUM_FRAMES << " pairs";
+}
+
+// logs the timings, only the counts are checked
+void benchmarkParticles() {
+	benchmarkManagers(10000);
+	benchmarkManagers(100000);
+	benchmarkSweep(10000);
+	benchmarkSweep(100000);
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#include "tests.h"
+
+#include "ofxParticleLOD.h"
+
+static const float FRAME_TIME = 1000.0f/60.0f; // vsynced 60 fps
+
+// run the governor for a number of frames at a frame time, the update &
+// draw are empty so they are well under budget
+static void runFrames(ofxParticleLOD& lod, unsigned int frames, float frameTime) {
+	for(unsigned int i = 0; i < frames; ++i) {
+		lod.evaluate(frameTime);
+		lod.beginUpdate();
+		lod.endUpdate();
+		lod.beginDraw();
+		lod.endDraw();
+	}
+}
+
+// raise the level with long frames & check it recovers at a steady 60 fps
+void testParticleLOD() {
+
+	ofxParticleLOD lod;
+	lod.setHysteresis(10, 60);
+	runFrames(lod, 1, FRAME_TIME); // first measurement
+
+	// long frames raise the level
+	runFrames(lod, 200, FRAME_TIME * 2);
+	CHECK(lod.getLevel() > 0);
+	CHECK(lod.getReasons() & ofxParticleLOD::FRAME_TIME);
+
+	// a capped app never runs faster than the target, back to full detail
+	runFrames(lod, 60 * (ofxParticleLOD::MAX_LEVEL + 1) + 100, FRAME_TIME);
+	CHECK(lod.getLevel() == 0);
+	CHECK(lod.getReasons() == ofxParticleLOD::NONE);
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#include "tests.h"
+
+#include "ofxParticleManagerT.h"
+#include "ofxParticlePoint.h"
+
+static const unsigned int NUM_PARTICLES = 10;
+
+// kill some particles & check the update compacts the list in order with
+// the motion & trail slots still lined up with their particles
+void testParticleManagerT() {
+
+	ofxParticleManagerT<ofxParticlePoint> particles;
+	particles.setMotionEnabled(true);
+	particles.setTrails(true);
+	for(unsigned int i = 0; i < NUM_PARTICLES; ++i) {
+		// the position & velocity both identify the particle
+		particles.addParticle(ofxParticlePoint(i, 0, 1, 1000000), i, 0);
+	}
+	particles.update(); // allocates the trails
+
+	// kill every third particle & remember the rest
+	std::vector<float> positions, velocities;
+	std::vector<unsigned int> slots;
+	for(unsigned int i = 0; i < particles.size(); ++i) {
+		if(i % 3 == 1) {
+			particles[i].kill();
+		}
+		else {
+			positions.push_back(particles[i].x);
+			velocities.push_back(particles.getMotion().vx[i]);
+			slots.push_back(particles.getTrail(i));
+		}
+	}
+	particles.update();
+
+	CHECK(particles.size() == positions.size());
+	CHECK(particles.getMotion().size() == particles.size());
+	for(unsigned int i = 0; i < particles.size() && i < positions.size(); ++i) {
+		CHECK(particles[i].x == positions[i]);
+		CHECK(particles.getMotion().vx[i] == velocities[i]);
+		CHECK(particles.getTrail(i) == slots[i]);
+		CHECK(particles.getTrail(i) != ofxParticleTrails::NO_SLOT);
+	}
+}
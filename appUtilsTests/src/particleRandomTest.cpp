@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#include "tests.h"
+
+#include "ofxParticleManager.h"
+
+static const unsigned int NUM_PARTICLES = 8;
+static const unsigned int NUM_VALUES = 4;
+
+// a particle that doesn't move or age
+class TestParticle : public ofxParticle {
+	public:
+		TestParticle() : ofxParticle(0, 0, 1, 1) {}
+		void update() {}
+		void draw() {}
+};
+
+// spawns test particles & remembers them, the manager owns them
+class TestEmitter : public ofxParticleEmitter {
+	public:
+		ofxParticle* spawn() {
+			spawned.push_back(new TestParticle);
+			return spawned.back();
+		}
+		std::vector<ofxParticle*> spawned;
+};
+
+// emit a burst of particles & check each gets its own id & random stream
+// that only depends on its own manager
+void testParticleRandom() {
+
+	ofxParticleManager particles;
+	particles.setRandomSeed(1234);
+	TestEmitter* emitter = new TestEmitter;
+	particles.addEmitter(emitter);
+	emitter->burst(NUM_PARTICLES);
+	particles.emit();
+	std::vector<ofxParticle*>& spawned = emitter->spawned;
+	CHECK(spawned.size() == NUM_PARTICLES);
+
+	std::vector<std::vector<unsigned int> > streams;
+	for(unsigned int i = 0; i < spawned.size(); ++i) {
+		ofxParticleRandom random = spawned[i]->getRandom();
+		std::vector<unsigned int> values;
+		for(unsigned int j = 0; j < NUM_VALUES; ++j) {
+			values.push_back(random.nextInt());
+		}
+		streams.push_back(values);
+	}
+	for(unsigned int i = 0; i < streams.size(); ++i) {
+		for(unsigned int j = i+1; j < streams.size(); ++j) {
+			CHECK(spawned[i]->getId() != spawned[j]->getId());
+			CHECK(streams[i] != streams[j]);
+		}
+	}
+
+	// another manager with a different seed doesn't change the streams
+	ofxParticleManager others;
+	others.setRandomSeed(5678);
+	others.addParticle(new TestParticle);
+	others.update();
+	for(unsigned int i = 0; i < spawned.size(); ++i) {
+		CHECK(spawned[i]->getRandom().nextInt() == streams[i][0]);
+	}
+}
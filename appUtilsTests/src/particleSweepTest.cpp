@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#include "tests.h"
+
+#include <algorithm>
+
+#include "ofxParticleRandom.h"
+#include "ofxParticleSweep.h"
+
+static const unsigned int NUM_RECTS = 500;
+static const unsigned int NUM_FRAMES = 10;
+static const float AREA = 400;
+
+// do 2 rects overlap? touching counts, sizes may be negative
+static bool overlaps(const ofRectangle& a, const ofRectangle& b) {
+	float ax1 = std::min(a.x, a.x + a.width), ax2 = std::max(a.x, a.x + a.width);
+	float ay1 = std::min(a.y, a.y + a.height), ay2 = std::max(a.y, a.y + a.height);
+	float bx1 = std::min(b.x, b.x + b.width), bx2 = std::max(b.x, b.x + b.width);
+	float by1 = std::min(b.y, b.y + b.height), by2 = std::max(b.y, b.y + b.height);
+	return ax1 <= bx2 && bx1 <= ax2 && ay1 <= by2 && by1 <= ay2;
+}
+
+// move random rects, some with negative sizes, for several frames & check
+// the sweep finds the same pairs as checking every pair
+void testParticleSweep() {
+
+	ofxParticleRandom random(42);
+	std::vector<ofRectangle> rects(NUM_RECTS);
+	for(unsigned int i = 0; i < rects.size(); ++i) {
+		rects[i].set(random.next(AREA), random.next(AREA),
+		             random.next(-10, 20), random.next(-10, 20));
+	}
+
+	ofxParticleSweep sweep;
+	for(unsigned int frame = 0; frame < NUM_FRAMES; ++frame) {
+
+		// drop the last few items every other frame
+		if(frame % 2 == 1) {
+			rects.resize(rects.size() - 10);
+		}
+		for(unsigned int i = 0; i < rects.size(); ++i) {
+			rects[i].x += random.nextSigned() * 4;
+			rects[i].y += random.nextSigned() * 4;
+			sweep.update(i, rects[i]);
+		}
+		sweep.resize(rects.size());
+
+		std::vector<ofxParticleSweep::Pair> pairs = sweep.findPairs();
+		std::vector<ofxParticleSweep::Pair> expected;
+		for(unsigned int i = 0; i < rects.size(); ++i) {
+			for(unsigned int j = i+1; j < rects.size(); ++j) {
+				if(overlaps(rects[i], rects[j])) {
+					expected.push_back(std::make_pair(i, j));
+				}
+			}
+		}
+		std::sort(pairs.begin(), pairs.end());
+		CHECK(!expected.empty());
+		CHECK(pairs == expected);
+	}
+}
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#pragma once
+
+#include "ofLog.h"
+
+/// number of failed checks, set by CHECK
+extern int testFailures;
+
+/// log & count a failed check without stopping the test
+#define CHECK(condition) \
+	if(!(condition)) { \
+		ofLogError("test") << __FILE__ << ":" << __LINE__ << ": failed: " << #condition; \
+		testFailures++; \
+	}
+
+/// the tests
+void testInputRecorder();
+void testParticleRandom();
+void testParticleLOD();
+void testParticleManagerT();
+void testParticleSweep();
+
+/// the benchmarks, log their timings
+void benchmarkParticles();
@@ -14,6 +14,7 @@
 #include "ofAppRunner.h"
 
 #include "ofxSceneManager.h"
+#include "ofxBitmapString.h"
 
 /// APP
 
@@ -32,6 +33,11 @@ ofxApp::ofxApp() : _currentWarpPoint(-1) {
 	_sceneManager = NULL;
 	_bSceneManagerUpdate = true;
 	_bSceneManagerDraw = true;
+	
+	_bQueueInput = false;
+	_bExitOnReplayEnd = false;
+	
+	_bEventRouting = false;
 
 #ifdef OFX_APP_UTILS_USE_CONTROL_PANEL
 	_bTransformControls = false;
@@ -49,7 +55,7 @@ void ofxApp::setMirrorX(bool mirrorX) {
 	_bMirrorX = mirrorX;
 #ifdef OFX_APP_UTILS_USE_CONTROL_PANEL
 	if(_bTransformControls)
-		controlPanel.setValueB("transformMirrorX", _bMirrorX);
+		_paramMirrorX.set(_bMirrorX);
 #endif
 }
 
@@ -57,7 +63,7 @@ void ofxApp::setMirrorY(bool mirrorY) {
 	_bMirrorY = mirrorY;
 #ifdef OFX_APP_UTILS_USE_CONTROL_PANEL
 	if(_bTransformControls)
-		controlPanel.setValueB("transformMirrorY", _bMirrorY);
+		_paramMirrorY.set(_bMirrorY);
 #endif
 }
 
@@ -65,9 +71,9 @@ void ofxApp::setOrigin(float x, float y, float z)	{
 	_origin.set(x, y, z);
 #ifdef OFX_APP_UTILS_USE_CONTROL_PANEL
 	if(_bTransformControls) {
-		controlPanel.setValueF("transformPos", x, 0);
-		controlPanel.setValueF("transformPos", y, 1);
-		controlPanel.setValueF("transformZ", x);
+		_paramOriginX.set(x);
+		_paramOriginY.set(y);
+		_paramOriginZ.set(z);
 	}
 #endif
 }
@@ -76,7 +82,7 @@ void ofxApp::setAspect(bool aspect) {
 	_bHandleAspect = aspect;
 #ifdef OFX_APP_UTILS_USE_CONTROL_PANEL
 	if(_bTransformControls)
-		controlPanel.setValueB("transformAspect", _bHandleAspect);
+		_paramAspect.set(_bHandleAspect);
 #endif
 }
 		
@@ -84,7 +90,7 @@ void ofxApp::setCentering(bool center) {
 	_bCenter = center;
 #ifdef OFX_APP_UTILS_USE_CONTROL_PANEL
 	if(_bTransformControls)
-		controlPanel.setValueB("transformCenter", _bCenter);
+		_paramCenter.set(_bCenter);
 #endif
 }
 
@@ -92,7 +98,7 @@ void ofxApp::setWarp(bool warp) {
 	_bWarp = warp;
 #ifdef OFX_APP_UTILS_USE_CONTROL_PANEL
 	if(_bTransformControls)
-		controlPanel.setValueB("transformEnableQuadWarper", _bWarp);
+		_paramWarp.set(_bWarp);
 #endif
 }
 
@@ -110,17 +116,34 @@ void ofxApp::addTransformControls(int panelNum, int panelCol) {
 		controlPanel.setWhichPanel(panelNum);
 	}
 	controlPanel.setWhichColumn(panelCol);
-	controlPanel.addSlider2D("position", "transformPosition", getOriginX(), getOriginY(),
+	
+	// keep the control handles so they don't have to be looked up by name
+	guiBaseObject* position = controlPanel.addSlider2D("position", "transformPosition",
+							 getOriginX(), getOriginY(),
 							 -getRenderWidth(), getRenderWidth(),
 							 -getRenderHeight(), getRenderHeight(), false);
-	controlPanel.addSlider("z", "transformZ", getOriginZ(), -1000, 200, false);
-	controlPanel.addToggle("keep aspect", "transformAspect", getOriginTranslate());
-	controlPanel.addToggle("center rendering", "transformCenter", getCentering());
-	controlPanel.addToggle("mirror x", "transformMirrorX", getMirrorX());
-	controlPanel.addToggle("mirror y", "transformMirrorY", getMirrorY());
-	controlPanel.addToggle("enable quad warper", "transformEnableQuadWarper", getWarp());
-	controlPanel.addToggle("edit quad warper", "transformEditQuadWarper", false);
-	controlPanel.addToggle("save quad warper", "transformSaveQuadWarper", false);
+	_paramOriginX.bind(position, 0);
+	_paramOriginY.bind(position, 1);
+	_paramOriginZ.bind(controlPanel.addSlider("z", "transformZ", getOriginZ(), -1000, 200, false));
+	_paramAspect.bind(controlPanel.addToggle("keep aspect", "transformAspect", getAspect()));
+	_paramCenter.bind(controlPanel.addToggle("center rendering", "transformCenter", getCentering()));
+	_paramMirrorX.bind(controlPanel.addToggle("mirror x", "transformMirrorX", getMirrorX()));
+	_paramMirrorY.bind(controlPanel.addToggle("mirror y", "transformMirrorY", getMirrorY()));
+	_paramWarp.bind(controlPanel.addToggle("enable quad warper", "transformEnableQuadWarper", getWarp()));
+	_paramEditWarp.bind(controlPanel.addToggle("edit quad warper", "transformEditQuadWarper", false));
+	_paramSaveWarp.bind(controlPanel.addToggle("save quad warper", "transformSaveQuadWarper", false));
+	
+	_transformParams.clear();
+	_transformParams.add(_paramOriginX);
+	_transformParams.add(_paramOriginY);
+	_transformParams.add(_paramOriginZ);
+	_transformParams.add(_paramAspect);
+	_transformParams.add(_paramCenter);
+	_transformParams.add(_paramMirrorX);
+	_transformParams.add(_paramMirrorY);
+	_transformParams.add(_paramWarp);
+	_transformParams.add(_paramEditWarp);
+	_transformParams.add(_paramSaveWarp);
 	_bTransformControls = true;
 }
 
@@ -149,10 +172,33 @@ void ofxApp::drawControlPanel() {
 
 #endif
 
+//--------------------------------------------------------------
+#ifndef OFX_APP_UTILS_NO_XML
+
+void ofxApp::watchWarpSettings(const string xmlFile) {
+	_settingsWatcher.setWarpFile(xmlFile);
+	_settingsWatcher.start();
+}
+
+#ifdef OFX_APP_UTILS_USE_CONTROL_PANEL
+void ofxApp::watchControlSettings(const string xmlFile) {
+	_settingsWatcher.setControlFile(xmlFile);
+	_settingsWatcher.start();
+}
+#endif
+
+void ofxApp::stopWatchingSettings() {
+	_settingsWatcher.stop();
+	_settingsWatcher.setWarpFile("");
+	_settingsWatcher.setControlFile("");
+}
+
+#endif
+
 //--------------------------------------------------------------
 void ofxApp::drawFramerate(float x, float y) {
 	ofSetColor(_framerateColor);
-	ofDrawBitmapString("fps: "+ofToString(ofGetFrameRate()), x, y);
+	ofxBitmapString(x, y) << "fps: " << ofGetFrameRate();
 }
 
 //--------------------------------------------------------------
@@ -205,47 +251,76 @@ void ofxApp::RunnerApp::update() {
 
 	app->mouseX = mouseX;
 	app->mouseY = mouseY;
+	
+	// advance the recorder frame clock & feed in any replayed events
+	app->_inputRecorder.beginFrame();
+	if(app->_inputRecorder.isReplaying())
+		replayEvents();
+
+#ifndef OFX_APP_UTILS_NO_XML
+	// swap in any reloaded settings before they're used this frame
+	ofVec2f warpPoints[4];
+	if(app->_settingsWatcher.getWarpChanges(warpPoints)) {
+		for(int i = 0; i < 4; ++i) {
+			app->setWarpPoint(i, warpPoints[i]);
+		}
+	}
+	#ifdef OFX_APP_UTILS_USE_CONTROL_PANEL
+		string controlFile;
+		if(app->_settingsWatcher.getControlChanges(controlFile)) {
+			app->controlPanel.loadSettings(controlFile);
+		}
+	#endif
+#endif
 
 #ifdef OFX_APP_UTILS_USE_CONTROL_PANEL
 	ofxControlPanel& controlPanel = app->controlPanel;
 
-	if(app->_bTransformControls) {
+	// only apply the control panel variables when a control has changed
+	if(app->_bTransformControls && app->_transformParams.sync()) {
 	
-		// grab control panel variables
-		app->_origin.set(controlPanel.getValueF("transformPosition", 0),	// x
-						 controlPanel.getValueF("transformPosition", 1),	// y
-						 controlPanel.getValueF("transformZ"));             // z
+		// origin
+		app->_origin.set(app->_paramOriginX, app->_paramOriginY, app->_paramOriginZ);
 		
 		// keep aspect?
-		app->_bHandleAspect = controlPanel.getValueB("transformAspect");
-		app->_bCenter = controlPanel.getValueB("transformCenter");
+		app->_bHandleAspect = app->_paramAspect;
+		app->_bCenter = app->_paramCenter;
 		
 		// mirror x/y?
-		app->_bMirrorX = controlPanel.getValueB("transformMirrorX");
-		app->_bMirrorY = controlPanel.getValueB("transformMirrorY");
+		app->_bMirrorX = app->_paramMirrorX;
+		app->_bMirrorY = app->_paramMirrorY;
 		
 		// enable quad warper?
-		app->_bWarp = controlPanel.getValueB("transformEnableQuadWarper");
+		app->_bWarp = app->_paramWarp;
 		
 		// edit quad warper?
-		if(controlPanel.getValueB("transformEditQuadWarper")) {
+		if(app->_paramEditWarp) {
 			app->setEditWarp(true);
-			controlPanel.setValueB("transformEditQuadWarper", false);
+			app->_paramEditWarp.set(false);
 		}
 		
 		// save quad warper?
-		if(controlPanel.getValueB("transformSaveQuadWarper")) {
+		if(app->_paramSaveWarp) {
 			//app->saveWarpSettings();
-			controlPanel.setValueB("transformSaveQuadWarper", false);
+			app->_paramSaveWarp.set(false);
 		}
+		
+		app->_transformParams.clearDirty();
 	}
 
 	controlPanel.update();
 #endif
 
+	// dispatch the input events queued since the last frame
+	if(app->_bQueueInput || !app->_inputQueue.empty())
+		app->_inputQueue.dispatch(*this);
+
 	if(app->_sceneManager && app->_bSceneManagerUpdate)
 		app->_sceneManager->update();
 	app->update();
+	
+	if(app->_sceneManager)
+		app->_inputRecorder.recordScene(app->_sceneManager->getCurrentSceneIndex());
 }
 
 //--------------------------------------------------------------
@@ -297,17 +372,14 @@ void ofxApp::RunnerApp::draw() {
 	}
 	
 	if(app->bDebug) {
-		stringstream text;
 		
 		// draw the quad warper editor
 		if(app->_bEditingWarpPoints) {
 		
 			ofSetHexColor(0x00FF00);
-			text << "Quad Warper Edit Mode" << endl
+			ofxBitmapString(28, 28) << "Quad Warper Edit Mode" << endl
 				 << "Drag from the corners of the screen" << endl
 				 << "Click center rectangle to exit";
-			ofDrawBitmapString(text.str(), 28, 28);
-			text.str("");
 				
 			// draw center exit box
 			ofNoFill();
@@ -324,10 +396,18 @@ void ofxApp::RunnerApp::draw() {
 		if(app->_bDrawFramerate)
 			app->drawFramerate(ofGetWidth()-100, ofGetHeight()-6);
 	}
+	
+	// draw all the text queued this frame in one go
+	if(ofxBitmapStringBatch::isEnabled())
+		ofxBitmapStringBatch::flush();
 }
 
 //--------------------------------------------------------------
 void ofxApp::RunnerApp::exit() {
+#ifndef OFX_APP_UTILS_NO_XML
+	app->_settingsWatcher.stop();
+#endif
+	app->_inputRecorder.stopRecording();
 	app->exit();
 	if(app->_sceneManager)
 		app->_sceneManager->clear();
@@ -335,9 +415,14 @@ void ofxApp::RunnerApp::exit() {
 
 //--------------------------------------------------------------
 void ofxApp::RunnerApp::keyPressed(int key) {
-	if(app->_sceneManager)
-		app->_sceneManager->keyPressed(key);
-	app->keyPressed(key);
+	ofxInputEvent event(ofxInputEvent::KEY_PRESSED, key);
+	if(capture(event))
+		return;
+	if(!route(event)) {
+		if(app->_sceneManager)
+			app->_sceneManager->keyPressed(key);
+		app->keyPressed(key);
+	}
 
 #ifdef OFX_APP_UTILS_USE_CONTROL_PANEL
 	if(app->bDebug) {
@@ -348,23 +433,38 @@ void ofxApp::RunnerApp::keyPressed(int key) {
 
 //--------------------------------------------------------------
 void ofxApp::RunnerApp::keyReleased(int key) {
-	if(app->_sceneManager)
-		app->_sceneManager->keyReleased(key);
-	app->keyReleased(key);
+	ofxInputEvent event(ofxInputEvent::KEY_RELEASED, key);
+	if(capture(event))
+		return;
+	if(!route(event)) {
+		if(app->_sceneManager)
+			app->_sceneManager->keyReleased(key);
+		app->keyReleased(key);
+	}
 }
 
 //--------------------------------------------------------------
 void ofxApp::RunnerApp::mouseMoved(int x, int y) {
-	if(app->_sceneManager)
-		app->_sceneManager->mouseMoved(x, y);
-	app->mouseMoved(x, y);
+	ofxInputEvent event(ofxInputEvent::MOUSE_MOVED, x, y);
+	if(capture(event))
+		return;
+	if(!route(event)) {
+		if(app->_sceneManager)
+			app->_sceneManager->mouseMoved(x, y);
+		app->mouseMoved(x, y);
+	}
 }
 
 //--------------------------------------------------------------
 void ofxApp::RunnerApp::mouseDragged(int x, int y, int button) {
-	if(app->_sceneManager)
-		app->_sceneManager->mouseDragged(x, y, button);
-	app->mouseDragged(x, y, button);
+	ofxInputEvent event(ofxInputEvent::MOUSE_DRAGGED, x, y, button);
+	if(capture(event))
+		return;
+	if(!route(event)) {
+		if(app->_sceneManager)
+			app->_sceneManager->mouseDragged(x, y, button);
+		app->mouseDragged(x, y, button);
+	}
 	
 	if(app->bDebug) {
 		if(app->_bEditingWarpPoints) {
@@ -383,9 +483,14 @@ void ofxApp::RunnerApp::mouseDragged(int x, int y, int button) {
 
 //--------------------------------------------------------------
 void ofxApp::RunnerApp::mousePressed(int x, int y, int button) {
-	if(app->_sceneManager)
-		app->_sceneManager->mousePressed(x, y, button);
-	app->mousePressed(x, y, button);
+	ofxInputEvent event(ofxInputEvent::MOUSE_PRESSED, x, y, button);
+	if(capture(event))
+		return;
+	if(!route(event)) {
+		if(app->_sceneManager)
+			app->_sceneManager->mousePressed(x, y, button);
+		app->mousePressed(x, y, button);
+	}
 	
 	if(app->bDebug) {
 		if(app->_bEditingWarpPoints) {
@@ -422,9 +527,14 @@ void ofxApp::RunnerApp::mousePressed(int x, int y, int button) {
 
 //--------------------------------------------------------------
 void ofxApp::RunnerApp::mouseReleased(int x, int y, int button) {
-	if(app->_sceneManager)
-		app->_sceneManager->mouseReleased(x, y, button);
-	app->mouseReleased(x, y, button);
+	ofxInputEvent event(ofxInputEvent::MOUSE_RELEASED, x, y, button);
+	if(capture(event))
+		return;
+	if(!route(event)) {
+		if(app->_sceneManager)
+			app->_sceneManager->mouseReleased(x, y, button);
+		app->mouseReleased(x, y, button);
+	}
 	
 #ifdef OFX_APP_UTILS_USE_CONTROL_PANEL
 	if(app->bDebug) {
@@ -438,6 +548,7 @@ void ofxApp::RunnerApp::mouseReleased(int x, int y, int button) {
 
 //--------------------------------------------------------------
 void ofxApp::RunnerApp::windowResized(int w, int h) {
+	app->_inputRecorder.recordResize(w, h);
 	if(app->_sceneManager)
 		app->_sceneManager->windowResized(w, h);
 	app->windowResized(w, h);
@@ -445,6 +556,7 @@ void ofxApp::RunnerApp::windowResized(int w, int h) {
 
 //--------------------------------------------------------------
 void ofxApp::RunnerApp::dragEvent(ofDragInfo dragInfo) {
+	app->_inputRecorder.recordDrag(dragInfo);
 	if(app->_sceneManager)
 		app->_sceneManager->dragEvent(dragInfo);
 	app->dragEvent(dragInfo);
@@ -452,6 +564,7 @@ void ofxApp::RunnerApp::dragEvent(ofDragInfo dragInfo) {
 
 //--------------------------------------------------------------
 void ofxApp::RunnerApp::gotMessage(ofMessage msg){
+	app->_inputRecorder.recordMessage(msg);
 	if(app->_sceneManager)
 		app->_sceneManager->gotMessage(msg);
 	app->gotMessage(msg);
@@ -500,33 +613,58 @@ void ofxApp::RunnerApp::audioRequested(float * output, int bufferSize, int nChan
 // ofxiPhoneApp
 //--------------------------------------------------------------
 void ofxApp::RunnerApp::touchDown(ofTouchEventArgs & touch) {
-	if(app->_sceneManager)
-		app->_sceneManager->touchDown(touch);
-	app->touchDown(touch);
+	ofxInputEvent event(ofxInputEvent::TOUCH_DOWN, touch);
+	if(capture(event))
+		return;
+	if(!route(event)) {
+		if(app->_sceneManager)
+			app->_sceneManager->touchDown(touch);
+		app->touchDown(touch);
+	}
 }
 
 void ofxApp::RunnerApp::touchMoved(ofTouchEventArgs & touch) {
-	if(app->_sceneManager)
-		app->_sceneManager->touchMoved(touch);
-	app->touchMoved(touch);
+	ofxInputEvent event(ofxInputEvent::TOUCH_MOVED, touch);
+	if(capture(event))
+		return;
+	if(!route(event)) {
+		if(app->_sceneManager)
+			app->_sceneManager->touchMoved(touch);
+		app->touchMoved(touch);
+	}
 }
 
 void ofxApp::RunnerApp::touchUp(ofTouchEventArgs & touch) {
-	if(app->_sceneManager)
-		app->_sceneManager->touchUp(touch);
-	app->touchUp(touch);
+	ofxInputEvent event(ofxInputEvent::TOUCH_UP, touch);
+	if(capture(event))
+		return;
+	if(!route(event)) {
+		if(app->_sceneManager)
+			app->_sceneManager->touchUp(touch);
+		app->touchUp(touch);
+	}
 }
 
 void ofxApp::RunnerApp::touchDoubleTap(ofTouchEventArgs & touch) {
-	if(app->_sceneManager)
-		app->_sceneManager->touchDoubleTap(touch);
-	app->touchDoubleTap(touch);
+	ofxInputEvent event(ofxInputEvent::TOUCH_DOUBLE_TAP, touch);
+	if(capture(event))
+		return;
+	if(!route(event)) {
+		if(app->_sceneManager)
+			app->_sceneManager->touchDoubleTap(touch);
+		app->touchDoubleTap(touch);
+	}
 }
 
 void ofxApp::RunnerApp::touchCancelled(ofTouchEventArgs & touch) {
-	if(app->_sceneManager)
-		app->_sceneManager->touchCancelled(touch);
-	app->touchCancelled(touch);
+	ofxInputEvent event(ofxInputEvent::TOUCH_CANCELLED, touch);
+	if(capture(event))
+		return;
+	if(!route(event)) {
+		if(app->_sceneManager)
+			app->_sceneManager->touchCancelled(touch);
+		app->touchCancelled(touch);
+	}
 }
 
 void ofxApp::RunnerApp::lostFocus() {
@@ -553,3 +691,82 @@ void ofxApp::RunnerApp::deviceOrientationChanged(int newOrientation) {
 	app->deviceOrientationChanged(newOrientation);
 }
 #endif
+
+/* ***** PRIVATE ***** */
+
+// don't record events which are being dispatched from the queue as they were
+// already recorded when they came in
+bool ofxApp::RunnerApp::capture(const ofxInputEvent& event) {
+	if(app->_inputQueue.isDispatching())
+		return false;
+	app->_inputRecorder.recordInput(event);
+	if(!app->_bQueueInput)
+		return false;
+	app->_inputQueue.push(event);
+	return true;
+}
+
+// scenes get the first chance to consume the event, then the app
+bool ofxApp::RunnerApp::route(const ofxInputEvent& event) {
+	if(!app->_bEventRouting)
+		return false;
+	if(app->_sceneManager == NULL || !app->_sceneManager->routeEvent(event))
+		app->_eventRouter.dispatch(event);
+	return true;
+}
+
+//--------------------------------------------------------------
+void ofxApp::RunnerApp::replayEvents() {
+	ofxInputRecorder::Event e;
+	while(app->_inputRecorder.nextEvent(e)) {
+		switch(e.type) {
+			case ofxInputEvent::KEY_PRESSED:
+				keyPressed(e.input.key); break;
+			case ofxInputEvent::KEY_RELEASED:
+				keyReleased(e.input.key); break;
+			case ofxInputEvent::MOUSE_MOVED:
+				mouseMoved(e.input.x, e.input.y); break;
+			case ofxInputEvent::MOUSE_DRAGGED:
+				mouseDragged(e.input.x, e.input.y, e.input.button); break;
+			case ofxInputEvent::MOUSE_PRESSED:
+				mousePressed(e.input.x, e.input.y, e.input.button); break;
+			case ofxInputEvent::MOUSE_RELEASED:
+				mouseReleased(e.input.x, e.input.y, e.input.button); break;
+		#ifdef TARGET_OF_IPHONE
+			case ofxInputEvent::TOUCH_DOWN:
+				touchDown(e.input.touch); break;
+			case ofxInputEvent::TOUCH_MOVED:
+				touchMoved(e.input.touch); break;
+			case ofxInputEvent::TOUCH_UP:
+				touchUp(e.input.touch); break;
+			case ofxInputEvent::TOUCH_DOUBLE_TAP:
+				touchDoubleTap(e.input.touch); break;
+			case ofxInputEvent::TOUCH_CANCELLED:
+				touchCancelled(e.input.touch); break;
+		#endif
+			case ofxInputRecorder::WINDOW_RESIZED:
+				windowResized(e.width, e.height); break;
+			case ofxInputRecorder::DRAG_EVENT:
+				dragEvent(e.dragInfo); break;
+			case ofxInputRecorder::GOT_MESSAGE:
+				gotMessage(ofMessage(e.message)); break;
+			case ofxInputRecorder::SCENE_CHANGED:
+				// scene changes come from the replayed input, only check that the
+				// replay is still in step with the recording
+				if(app->_sceneManager && app->_sceneManager->getCurrentSceneIndex() != e.scene) {
+					ofLogWarning("ofxApp") << "replay diverged on frame " << e.frame
+						<< ": recorded scene " << e.scene << ", current scene "
+						<< app->_sceneManager->getCurrentSceneIndex();
+				}
+				break;
+			default:
+				break;
+		}
+	}
+	
+	if(app->_inputRecorder.isReplayDone()) {
+		app->_inputRecorder.stopReplay();
+		if(app->_bExitOnReplayEnd)
+			ofExit();
+	}
+}
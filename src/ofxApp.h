@@ -25,6 +25,11 @@
 #include "ofxQuadWarper.h"
 #include "ofxTransformer.h"
 #include "ofxTimer.h"
+#include "ofxSettingsWatcher.h"
+#include "ofxParameterBinding.h"
+#include "ofxInputQueue.h"
+#include "ofxInputRecorder.h"
+#include "ofxEventRouter.h"
 
 class ofxSceneManager;
 
@@ -140,6 +145,30 @@ class ofxApp :
 		void drawControlPanel();
 #endif
 
+#ifndef OFX_APP_UTILS_NO_XML
+
+	/// \section Settings Reloading
+	///
+	/// watch the settings files and reload them when they are changed on disk,
+	/// the files are parsed on a separate thread and the new settings are
+	/// applied at the beginning of the next update
+	///
+	
+		/// reload the quad warper settings when the file changes
+		void watchWarpSettings(const string xmlFile="quadWarper.xml");
+	
+	#ifdef OFX_APP_UTILS_USE_CONTROL_PANEL
+		/// reload the control panel settings when the file changes
+		void watchControlSettings(const string xmlFile="controlPanelSettings.xml");
+	#endif
+		
+		/// stop watching all settings files
+		void stopWatchingSettings();
+		
+		/// access to the watcher, ie to change the poll interval
+		ofxSettingsWatcher& getSettingsWatcher() {return _settingsWatcher;}
+#endif
+
 	/// \section Drawing the Framerate (as text, default lower right corner)
 
 		/// draw the framerate automatically in debug mode? (on by default)
@@ -150,6 +179,10 @@ class ofxApp :
 		ofColor& getFramerateColorRef() {return _framerateColor;}
 		
 		/// draw the framerate text manually
+		///
+		/// note: the framerate & debug text are queued when
+		///       ofxBitmapStringBatch is enabled, the queue is flushed
+		///       automatically at the end of draw
 		void drawFramerate(float x, float y);
 
 	/// \section SceneManager
@@ -174,6 +207,60 @@ class ofxApp :
 		void setSceneManagerDraw(bool draw)     {_bSceneManagerDraw = draw;}
 		bool getSceneManagerDraw()              {return _bSceneManagerDraw;} 
 	
+	/// \section Input Queue
+	
+		/// queue the key, mouse, and touch events & dispatch them once per
+		/// frame during update() (off by default)
+		///
+		/// consecutive moves & drags are coalesced, see getInputQueue() for
+		/// the per frame event counts & full event history
+		///
+		/// note: dispatching happens after the replayed events, reloaded
+		///       settings, & the control panel update and before the scene
+		///       manager & app updates
+		///
+		void setQueueInput(bool queue) {_bQueueInput = queue;}
+		bool getQueueInput()           {return _bQueueInput;}
+		ofxInputQueue& getInputQueue() {return _inputQueue;}
+	
+	/// \section Event Routing
+	
+		/// route the key, mouse, and touch events through subscriber lists
+		/// instead of calling every input callback (off by default)
+		///
+		/// when on, the current scene's router (see ofxScene::getEventRouter)
+		/// gets the event first, then the app's router if the scene didn't
+		/// consume it, the regular ofBaseApp input callbacks are not called
+		///
+		/// note: the built in warp editor & control panel input handling
+		///       is not affected
+		///
+		void setEventRouting(bool route) {_bEventRouting = route;}
+		bool getEventRouting()           {return _bEventRouting;}
+		
+		/// subscribe app handlers here, ie:
+		///     getEventRouter().add(ofxInputEvent::KEY_PRESSED, this, &testApp::key);
+		ofxEventRouter& getEventRouter() {return _eventRouter;}
+	
+	/// \section Input Recording & Replay
+	
+		/// record all callbacks forwarded to the app & scene manager along
+		/// with scene changes to a log or replay a log, ie:
+		///
+		///     getInputRecorder().startRecording("show.bin");
+		///     getInputRecorder().startReplay("show.bin"); // full speed
+		///
+		/// replayed events are fed in at the beginning of update(), recorded
+		/// scene changes are not replayed, the replayed input makes the same
+		/// changes through the same enter & exit, a warning is printed if the
+		/// current scene differs from the recording
+		ofxInputRecorder& getInputRecorder() {return _inputRecorder;}
+		
+		/// exit the app once a replay is finished? (off by default),
+		/// useful for unattended benchmark runs
+		void setExitOnReplayEnd(bool exit) {_bExitOnReplayEnd = exit;}
+		bool getExitOnReplayEnd()          {return _bExitOnReplayEnd;}
+	
 	/// \section Util
 			
 		/// is debug mode on? (show control panel and fps, allow editing of warper)
@@ -203,9 +290,29 @@ class ofxApp :
 		ofxSceneManager* _sceneManager; ///< optional built in scene manager
 		bool _bSceneManagerUpdate, _bSceneManagerDraw;
 		
+		ofxInputQueue _inputQueue; ///< queued input events
+		bool _bQueueInput;         ///< queue input events?
+		
+		ofxEventRouter _eventRouter; ///< app input subscribers
+		bool _bEventRouting;         ///< route input through the subscribers?
+		
+		ofxInputRecorder _inputRecorder; ///< input recording & replay
+		bool _bExitOnReplayEnd;          ///< exit when the replay is done?
+		
+#ifndef OFX_APP_UTILS_NO_XML
+		ofxSettingsWatcher _settingsWatcher; ///< settings file hot reloading
+#endif
+
 #ifdef OFX_APP_UTILS_USE_CONTROL_PANEL
 		bool _bTransformControls;   ///< have the projection controls been added?
 		bool _bDrawControlPanel;    ///< draw the control panel automatically?
+		
+		/// transform controls bound to their control panel objects
+		ofxParameterGroup _transformParams;
+		ofxBoundParameter<float> _paramOriginX, _paramOriginY, _paramOriginZ;
+		ofxBoundParameter<bool> _paramAspect, _paramCenter,
+		                        _paramMirrorX, _paramMirrorY,
+		                        _paramWarp, _paramEditWarp, _paramSaveWarp;
 #endif
 
 	public:
@@ -271,6 +378,18 @@ class ofxApp :
 				
 			private:
 			
+				/// record an input event & queue it if input queueing is on
+				/// and it's not currently being dispatched, returns true if
+				/// queued
+				bool capture(const ofxInputEvent& event);
+				
+				/// send an input event through the event routers if event
+				/// routing is on, returns false if routing is off
+				bool route(const ofxInputEvent& event);
+				
+				/// feed in the replayed events due this frame
+				void replayEvents();
+			
 				ofxApp* app;
 		};
 		
@@ -15,9 +15,14 @@
 #include "ofxApp.h"
 #include "ofxScene.h"
 #include "ofxSceneManager.h"
+#include "ofxSceneCompositor.h"
 #include "ofxTimer.h"
 #include "ofxParticleManager.h"
+#include "ofxParticleManagerT.h"
 #include "ofxBitmapString.h"
+#include "ofxBitmapStringBatch.h"
+#include "ofxParameterBinding.h"
+#include "ofxEventRouter.h"
 
 /// replace ofRunApp with this in main.cpp ...
 inline void ofRunAppWithAppUtils(ofxApp* app) {
@@ -10,19 +10,37 @@
  */
 #pragma once
 
+#include <string>
+#include <sstream>
+#include <cmath>
+
 #include "ofGraphics.h"
 #include "ofVectorMath.h"
 
+#include "ofxBitmapStringBatch.h"
+
+/// size of the ofxBitmapString text buffer, longer strings are cut off,
+/// define this in your CFLAGS to change it
+#ifndef OFX_BITMAP_STRING_SIZE
+	#define OFX_BITMAP_STRING_SIZE 256
+#endif
+
 //------------------------------------------------------------------------------
 /// \class ofxBitmapStream
 /// \brief a stream interface to ofDrawBitmapStream
 ///
 /// ofxBitmapStream accepts variables via the ostream operator <<, builds a string,
-/// and logs it when the stream is finished (via the destructor). All the stream
-/// controls work (endl, flush, hex, etc).
+/// and logs it when the stream is finished (via the destructor). The endl, flush,
+/// hex, dec, & oct stream controls work.
 ///
 /// Usage: ofxBitmapString(10, 10) << "a string" << 100 << 20.234f;
 ///
+/// Strings, characters, bools, and numbers are formatted directly into a fixed
+/// size buffer on the stack without iostreams, locales, or heap allocations.
+/// Floats are written like the stream default: 6 significant digits, switching
+/// to scientific notation for very large or small values. Any other type
+/// (ofVec3f, ofColor, etc) falls back to its ostream operator.
+///
 /// class idea from:
 ///     http://www.gamedev.net/community/forums/topic.asp?topic_id=525405&whichpage=1&#3406418
 /// how to catch std::endl (which is actually a func pointer):
@@ -31,37 +49,245 @@
 class ofxBitmapString {
 	public:
 
-		ofxBitmapString(const ofPoint & p) {
-			pos = p;
+		ofxBitmapString(const ofPoint & p) : pos(p), length(0), base(10) {
+			text[0] = '\0';
 		}
-		
-		ofxBitmapString(float x, float y, float z=0.0f) {
+
+		ofxBitmapString(float x, float y, float z=0.0f) : length(0), base(10) {
 			pos.set(x, y, z);
+			text[0] = '\0';
 		}
-		
-		/// does the actual printing on when the ostream is done
+
+		/// does the actual printing on when the ostream is done,
+		/// queues the text instead if ofxBitmapStringBatch is enabled
 		~ofxBitmapString() {
-			ofDrawBitmapString(message.str(), pos.x, pos.y, pos.z);
+			if(ofxBitmapStringBatch::isBatching()) {
+				ofxBitmapStringBatch::add(text, length, pos.x, pos.y, pos.z);
+				return;
+			}
+			// reuse the same string memory for every draw
+			static std::string message;
+			message.assign(text, length);
+			ofDrawBitmapString(message, pos.x, pos.y, pos.z);
+		}
+
+		/// strings & characters
+		ofxBitmapString& operator<<(const char* value) {
+			if(value != NULL) {
+				append(value, strlen(value));
+			}
+			return *this;
+		}
+		ofxBitmapString& operator<<(const std::string& value) {
+			append(value.c_str(), value.size());
+			return *this;
+		}
+		ofxBitmapString& operator<<(char value) {
+			append(&value, 1);
+			return *this;
 		}
-		
-		/// catch the << ostream with a template class to read any type of data
-		template <class T> 
+		ofxBitmapString& operator<<(bool value) {
+			return *this << (value ? '1' : '0'); // same as the stream default
+		}
+
+		/// integers
+		ofxBitmapString& operator<<(short value)          {return appendInt(value, (unsigned short) value);}
+		ofxBitmapString& operator<<(unsigned short value) {return appendInt(value, value);}
+		ofxBitmapString& operator<<(int value)            {return appendInt(value, (unsigned int) value);}
+		ofxBitmapString& operator<<(unsigned int value)   {return appendInt(value, value);}
+		ofxBitmapString& operator<<(long value)           {return appendInt(value, (unsigned long) value);}
+		ofxBitmapString& operator<<(unsigned long value)  {return appendInt(value, value);}
+		ofxBitmapString& operator<<(long long value)      {return appendInt(value, (unsigned long long) value);}
+		ofxBitmapString& operator<<(unsigned long long value) {return appendInt(value, value);}
+
+		/// floating point
+		ofxBitmapString& operator<<(float value)  {appendFloat(value); return *this;}
+		ofxBitmapString& operator<<(double value) {appendFloat(value); return *this;}
+
+		/// catch the << ostream with a template class to read any other type
+		/// of data, note: this is the slow path through an ostringstream
+		template <class T>
 		ofxBitmapString& operator<<(const T& value) {
-			message << value;
+			std::ostringstream stream;
+			if(base == 16) stream << std::hex;
+			else if(base == 8) stream << std::oct;
+			stream << value;
+			std::string s = stream.str();
+			append(s.c_str(), s.size());
 			return *this;
 		}
 
-		/// catch the << ostream function pointers such as std::endl and std::hex
+		/// catch the << ostream function pointers such as std::endl
 		ofxBitmapString& operator<<(std::ostream& (*func)(std::ostream&)) {
-			func(message);
+			if(func == static_cast<std::ostream& (*)(std::ostream&)>(std::endl)) {
+				append("\n", 1);
+			}
+			else if(func == static_cast<std::ostream& (*)(std::ostream&)>(std::ends)) {
+				append("\0", 1);
+			}
+			// flush has nothing to do
+			return *this;
+		}
+
+		/// catch the << ios base function pointers such as std::hex & std::dec
+		ofxBitmapString& operator<<(std::ios_base& (*func)(std::ios_base&)) {
+			if(func == static_cast<std::ios_base& (*)(std::ios_base&)>(std::hex)) {
+				base = 16;
+			}
+			else if(func == static_cast<std::ios_base& (*)(std::ios_base&)>(std::oct)) {
+				base = 8;
+			}
+			else if(func == static_cast<std::ios_base& (*)(std::ios_base&)>(std::dec)) {
+				base = 10;
+			}
 			return *this;
 		}
-		
+
 	private:
-	
-		ofPoint pos;                ///< temp position
-		std::ostringstream message; ///< temp buffer
-		
+
+		/// append characters, cuts off at the end of the buffer
+		void append(const char* s, unsigned int size) {
+			if(length + size > OFX_BITMAP_STRING_SIZE - 1) {
+				size = OFX_BITMAP_STRING_SIZE - 1 - length;
+			}
+			memcpy(text + length, s, size);
+			length += size;
+			text[length] = '\0';
+		}
+
+		/// write the digits of an unsigned value in the current base
+		template <class U>
+		void appendUnsigned(U value) {
+			static const char digits[] = "0123456789abcdef";
+			char buffer[32]; // enough for 64 bits in octal
+			int i = sizeof(buffer);
+			do {
+				buffer[--i] = digits[value % base];
+				value /= base;
+			} while(value != 0);
+			append(buffer + i, sizeof(buffer) - i);
+		}
+
+		/// signed values are written as unsigned in hex & octal, same as streams
+		template <class S, class U>
+		ofxBitmapString& appendInt(S value, U bits) {
+			if(base != 10 || value >= 0) {
+				appendUnsigned(bits);
+			}
+			else {
+				append("-", 1);
+				appendUnsigned((U) (0 - bits));
+			}
+			return *this;
+		}
+
+		/// write a float with 6 significant digits (%g style)
+		void appendFloat(double value) {
+			if(value != value) {
+				append("nan", 3);
+				return;
+			}
+			if(value < 0 || (value == 0 && 1/value < 0)) {
+				append("-", 1);
+				value = -value;
+			}
+			if(value > 1.7976931348623157e308) {
+				append("inf", 3);
+				return;
+			}
+			if(value == 0) {
+				append("0", 1);
+				return;
+			}
+
+			// round to 6 significant digits: digits = d.ddddd * 10^exponent
+			int exponent = (int) floor(log10(value));
+			unsigned long long digits = scaleDigits(value, exponent);
+			if(digits < 100000ULL) { // log10 came out a hair high
+				exponent--;
+				digits = scaleDigits(value, exponent);
+			}
+			if(digits >= 1000000ULL) { // rounded up to the next power of 10
+				digits /= 10;
+				exponent++;
+			}
+
+			int saveBase = base;
+			base = 10;
+			if(exponent < -4 || exponent >= 6) { // scientific
+				appendDigits(digits, 0);
+				append("e", 1);
+				append(exponent < 0 ? "-" : "+", 1);
+				if(exponent < 0) exponent = -exponent;
+				if(exponent < 10) append("0", 1);
+				appendUnsigned((unsigned int) exponent);
+			}
+			else { // fixed
+				appendDigits(digits, exponent);
+			}
+			base = saveBase;
+		}
+
+		/// write 6 significant digits with the decimal point after the
+		/// digit at exponent, trims trailing zeros
+		void appendDigits(unsigned long long digits, int exponent) {
+			char buffer[6];
+			for(int i = 5; i >= 0; --i) {
+				buffer[i] = '0' + (digits % 10);
+				digits /= 10;
+			}
+			int last = 5; // last non zero digit
+			while(last > 0 && buffer[last] == '0') {
+				last--;
+			}
+			if(exponent < 0) { // 0.000ddd
+				append("0.", 2);
+				for(int i = -1; i > exponent; --i) {
+					append("0", 1);
+				}
+				append(buffer, last+1);
+			}
+			else { // ddd.ddd
+				append(buffer, exponent+1);
+				if(last > exponent) {
+					append(".", 1);
+					append(buffer + exponent+1, last-exponent);
+				}
+			}
+		}
+
+		/// value / 10^(exponent-5) rounded, avoids underflow for denormals
+		static unsigned long long scaleDigits(double value, int exponent) {
+			int e = exponent - 5;
+			if(e < -300) {
+				value *= 1e300;
+				e += 300;
+			}
+			double scaled = value / powerOf10(e);
+			unsigned long long digits = (unsigned long long) scaled;
+			double remainder = scaled - digits;
+			if(remainder > 0.5 || (remainder == 0.5 && (digits & 1))) {
+				digits++; // round half to even, same as printf
+			}
+			return digits;
+		}
+
+		/// 10^exponent without going through pow's general case
+		static double powerOf10(int exponent) {
+			static const double table[] = {
+				1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+				1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+			};
+			if(exponent >= 0 && exponent <= 22) return table[exponent];
+			if(exponent < 0 && exponent >= -22) return 1.0 / table[-exponent];
+			return pow(10.0, exponent);
+		}
+
+		ofPoint pos;                              ///< temp position
+		char text[OFX_BITMAP_STRING_SIZE];        ///< temp buffer
+		unsigned int length;                      ///< current text length
+		int base;                                 ///< integer base: 8, 10, or 16
+
 		ofxBitmapString(ofxBitmapString const&) {} // not defined, not copyable
 		ofxBitmapString& operator=(ofxBitmapString& from) {return *this;} // not defined, not assignable
 };
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#include "ofxBitmapStringBatch.h"
+
+#include "ofGraphics.h"
+#include "ofBitmapFont.h"
+
+// bitmap font layout, same as ofDrawBitmapString:
+// the font texture is a 16x16 grid of 16x16 px cells in a 256x256 texture,
+// each glyph uses the upper left 8x14 px of its cell
+static const float GLYPH_WIDTH = 8;        // advance & quad width in px
+static const float GLYPH_TOP = -11;        // quad top relative to the baseline
+static const float GLYPH_BOTTOM = 3;       // quad bottom relative to the baseline
+static const float LINE_HEIGHT = 8 * 1.7;  // px between lines
+static const int TAB_WIDTH = 4;            // tab stop every 4 columns
+
+/// BITMAP STRING BATCH
+
+bool ofxBitmapStringBatch::_bEnabled = false;
+bool ofxBitmapStringBatch::_bGlyphsSetup = false;
+unsigned int ofxBitmapStringBatch::_numSuspended = 0;
+ofxBitmapStringBatch::Glyph ofxBitmapStringBatch::_glyphs[128];
+std::vector<ofxBitmapStringBatch::Entry> ofxBitmapStringBatch::_entries;
+std::vector<char> ofxBitmapStringBatch::_text;
+std::vector<float> ofxBitmapStringBatch::_vertices;
+std::vector<float> ofxBitmapStringBatch::_texCoords;
+std::vector<unsigned char> ofxBitmapStringBatch::_colors;
+unsigned int ofxBitmapStringBatch::_numStrings = 0;
+unsigned int ofxBitmapStringBatch::_numGlyphs = 0;
+
+//--------------------------------------------------------------
+void ofxBitmapStringBatch::add(const char* text, unsigned int length, float x, float y, float z) {
+	if(text == NULL || length == 0)
+		return;
+
+	// project the anchor to the window like the ofDrawBitmapString billboard
+	// mode, the matrices are column major gl matrices
+	ofMatrix4x4 modelview = ofGetCurrentMatrix(OF_MATRIX_MODELVIEW);
+	ofMatrix4x4 projection = ofGetCurrentMatrix(OF_MATRIX_PROJECTION);
+	const float* m = modelview.getPtr();
+	const float* p = projection.getPtr();
+	float eye[4], clip[4];
+	for(int i = 0; i < 4; ++i) {
+		eye[i] = m[i]*x + m[4+i]*y + m[8+i]*z + m[12+i];
+	}
+	for(int i = 0; i < 4; ++i) {
+		clip[i] = p[i]*eye[0] + p[4+i]*eye[1] + p[8+i]*eye[2] + p[12+i]*eye[3];
+	}
+	if(clip[3] <= 0) // behind the camera
+		return;
+	float depth = clip[2] / clip[3];
+	if(depth < -1 || depth > 1)
+		return;
+	ofRectangle viewport = ofGetCurrentViewport();
+
+	Entry e;
+	e.color = ofGetStyle().color;
+	e.x = viewport.x + (clip[0] / clip[3] + 1) * 0.5f * viewport.width;
+	e.y = viewport.y + (1 - clip[1] / clip[3]) * 0.5f * viewport.height;
+	e.depth = depth;
+	e.offset = _text.size();
+	e.length = length;
+	_text.insert(_text.end(), text, text + length);
+	_entries.push_back(e);
+}
+
+//--------------------------------------------------------------
+void ofxBitmapStringBatch::flush() {
+
+	_numStrings = _entries.size();
+	_numGlyphs = 0;
+	if(_entries.empty())
+		return;
+
+	if(!_bGlyphsSetup)
+		setupGlyphs();
+
+	// build all the glyph quads in window pixels,
+	// the buffers keep their memory between frames
+	_vertices.clear();
+	_texCoords.clear();
+	_colors.clear();
+	for(unsigned int i = 0; i < _entries.size(); ++i) {
+		const Entry& e = _entries[i];
+		const char* text = &_text[e.offset];
+		float sx = e.x, sy = e.y;
+		int column = 0;
+		for(unsigned int c = 0; c < e.length; ++c) {
+			unsigned char ch = text[c];
+			if(ch == '\n') {
+				sy += LINE_HEIGHT;
+				sx = e.x;
+				column = 0;
+			}
+			else if(ch == '\t') {
+				int next = column + TAB_WIDTH - (column % TAB_WIDTH);
+				sx += GLYPH_WIDTH * (next - column);
+				column = next;
+			}
+			else if(ch >= 32) { // skip control characters
+				if(ch < 128 && ch != ' ') {
+					addGlyph(_glyphs[ch], (int) sx, (int) sy, e.depth, e.color);
+				}
+				sx += GLYPH_WIDTH;
+				column++;
+			}
+		}
+	}
+	_numGlyphs = _vertices.size() / 18; // 6 verts * 3 floats
+
+	// the vertices are in window pixels, draw with a y down ortho projection
+	// over the viewport & an identity modelview, glOrtho maps z to -z
+	ofRectangle viewport = ofGetCurrentViewport();
+	ofPushStyle();
+	ofEnableAlphaBlending();
+	glMatrixMode(GL_PROJECTION);
+	glPushMatrix();
+	glLoadIdentity();
+	glOrtho(viewport.x, viewport.x + viewport.width,
+	        viewport.y + viewport.height, viewport.y, -1, 1);
+	glMatrixMode(GL_MODELVIEW);
+	glPushMatrix();
+	glLoadIdentity();
+
+	ofTexture& texture = ofBitmapStringGetTextureRef();
+	texture.bind();
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+	glEnableClientState(GL_COLOR_ARRAY);
+	glVertexPointer(3, GL_FLOAT, 0, &_vertices[0]);
+	glTexCoordPointer(2, GL_FLOAT, 0, &_texCoords[0]);
+	glColorPointer(4, GL_UNSIGNED_BYTE, 0, &_colors[0]);
+	glDrawArrays(GL_TRIANGLES, 0, _numGlyphs * 6);
+	glDisableClientState(GL_COLOR_ARRAY);
+	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
+	texture.unbind();
+
+	glMatrixMode(GL_PROJECTION);
+	glPopMatrix();
+	glMatrixMode(GL_MODELVIEW);
+	glPopMatrix();
+	ofPopStyle();
+
+	clear();
+}
+
+//--------------------------------------------------------------
+void ofxBitmapStringBatch::suspend() {
+	if(_numSuspended == 0 && _bEnabled) {
+		flush(); // still drawing to the screen
+	}
+	_numSuspended++;
+}
+
+//--------------------------------------------------------------
+void ofxBitmapStringBatch::resume() {
+	if(_numSuspended == 0) {
+		ofLogWarning("ofxBitmapStringBatch") << "resume() called without suspend()";
+		return;
+	}
+	_numSuspended--;
+}
+
+//--------------------------------------------------------------
+void ofxBitmapStringBatch::clear() {
+	_entries.clear();
+	_text.clear();
+}
+
+/* ***** PRIVATE ***** */
+
+//--------------------------------------------------------------
+void ofxBitmapStringBatch::setupGlyphs() {
+	const float cell = 1.0f / 16.0f;     // cell size in tex coords
+	const float width = 8.0f / 256.0f;   // glyph size in tex coords
+	const float height = 14.0f / 256.0f;
+	for(int i = 0; i < 128; ++i) {
+		Glyph& g = _glyphs[i];
+		g.u1 = (i % 16) * cell;
+		g.v1 = (i / 16) * cell;
+		g.u2 = g.u1 + width;
+		g.v2 = g.v1 + height;
+	}
+	_bGlyphsSetup = true;
+}
+
+//--------------------------------------------------------------
+void ofxBitmapStringBatch::addGlyph(const Glyph& glyph, float x, float y, float depth,
+                                    const ofColor& color) {
+
+	const float corners[6][4] = {
+		// x offset, y offset, u, v
+		{0,           GLYPH_TOP,    glyph.u1, glyph.v1},
+		{GLYPH_WIDTH, GLYPH_TOP,    glyph.u2, glyph.v1},
+		{GLYPH_WIDTH, GLYPH_BOTTOM, glyph.u2, glyph.v2},
+		{0,           GLYPH_TOP,    glyph.u1, glyph.v1},
+		{GLYPH_WIDTH, GLYPH_BOTTOM, glyph.u2, glyph.v2},
+		{0,           GLYPH_BOTTOM, glyph.u1, glyph.v2}
+	};
+
+	for(int i = 0; i < 6; ++i) {
+		_vertices.push_back(x + corners[i][0]);
+		_vertices.push_back(y + corners[i][1]);
+		_vertices.push_back(-depth);
+		_texCoords.push_back(corners[i][2]);
+		_texCoords.push_back(corners[i][3]);
+		_colors.push_back(color.r);
+		_colors.push_back(color.g);
+		_colors.push_back(color.b);
+		_colors.push_back(color.a);
+	}
+}
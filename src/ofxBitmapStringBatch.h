@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#pragma once
+
+#include <vector>
+
+#include "ofConstants.h"
+#include "ofColor.h"
+#include "ofVectorMath.h"
+
+/**
+	\class  BitmapStringBatch
+	\brief  queues bitmap strings during a frame & draws them in one batch
+
+	when enabled, ofxBitmapString & the ofxApp framerate/debug text are added
+	to the queue instead of being drawn right away, each string remembers the
+	window position of its anchor point & the color it was added with so
+	strings added inside pushed transforms still land in the right place
+
+	like the default ofDrawBitmapString billboard mode, only the anchor point
+	is transformed by the current matrices & the glyphs are laid out in
+	window pixels, so the text isn't scaled or rotated by the transform
+
+	the glyph quads are built on the CPU from a cached glyph table using the
+	built in bitmap font texture & submitted with a single draw call when
+	flushed, ofxApp flushes automatically at the end of draw()
+
+	strings are drawn to the screen with the projection that's current when
+	flushed, so batching is suspended while drawing into an fbo: queued
+	strings are flushed & new strings are drawn right away until it resumes,
+	the scene manager & compositor do this for their fbos, wrap your own fbo
+	drawing with suspend() & resume()
+**/
+class ofxBitmapStringBatch {
+	public:
+
+		/// enable/disable batching (off by default)
+		static void setEnabled(bool enabled) {_bEnabled = enabled;}
+		static bool isEnabled()              {return _bEnabled;}
+
+		/// is batching enabled & not suspended? ofxBitmapString queues
+		/// strings when true & draws them right away otherwise
+		static bool isBatching() {return _bEnabled && _numSuspended == 0;}
+
+		/// suspend batching while drawing into an fbo, flushes the queued
+		/// strings first, call before ofFbo::begin() & call resume() after
+		/// ofFbo::end(), calls can be nested
+		static void suspend();
+		static void resume();
+
+		/// queue a string at a position in the current transform using the
+		/// current style color, use the ofDrawBitmapString layout, strings
+		/// whose anchor is outside the depth range are skipped
+		static void add(const char* text, unsigned int length, float x, float y, float z=0);
+		static void add(const std::string& text, float x, float y, float z=0) {
+			add(text.c_str(), text.size(), x, y, z);
+		}
+
+		/// build & draw all queued strings, then clear the queue
+		static void flush();
+
+		/// discard all queued strings
+		static void clear();
+
+		/// number of strings & glyphs drawn in the last flush
+		static unsigned int getNumStrings() {return _numStrings;}
+		static unsigned int getNumGlyphs()  {return _numGlyphs;}
+
+	private:
+
+		/// a queued string
+		struct Entry {
+			ofColor color;       ///< color when added
+			float x, y;          ///< anchor in window pixels, y down
+			float depth;         ///< anchor depth, -1 to 1
+			unsigned int offset; ///< start in the text buffer
+			unsigned int length; ///< text length
+		};
+
+		/// glyph texture coords
+		struct Glyph {
+			float u1, v1, u2, v2;
+		};
+
+		/// fill the glyph table
+		static void setupGlyphs();
+
+		/// append the 6 vertices of a glyph quad at a window position
+		static void addGlyph(const Glyph& glyph, float x, float y, float depth,
+		                     const ofColor& color);
+
+		static bool _bEnabled;             ///< is batching on?
+		static bool _bGlyphsSetup;         ///< has the glyph table been filled?
+		static unsigned int _numSuspended; ///< suspend() nesting depth
+		static Glyph _glyphs[128];         ///< cached glyph table
+
+		static std::vector<Entry> _entries; ///< queued strings
+		static std::vector<char> _text;     ///< queued text, all strings
+
+		static std::vector<float> _vertices;  ///< x, y, z per vertex
+		static std::vector<float> _texCoords; ///< u, v per vertex
+		static std::vector<unsigned char> _colors; ///< r, g, b, a per vertex
+
+		static unsigned int _numStrings, _numGlyphs; ///< last flush stats
+};
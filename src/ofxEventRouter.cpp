@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#include "ofxEventRouter.h"
+
+#include "ofLog.h"
+
+/// EVENT ROUTER
+
+//--------------------------------------------------------------
+void ofxEventRouter::remove(ofxInputEvent::Type type, void* listener) {
+	if(type >= ofxInputEvent::NUM_TYPES)
+		return;
+	std::vector<Subscriber>& list = _subscribers[type];
+	for(unsigned int i = 0; i < list.size();) {
+		if(list[i].listener == listener) {
+			delete list[i].delegate;
+			list.erase(list.begin()+i);
+		}
+		else {
+			++i;
+		}
+	}
+}
+
+void ofxEventRouter::remove(void* listener) {
+	for(int i = 0; i < ofxInputEvent::NUM_TYPES; ++i) {
+		remove((ofxInputEvent::Type) i, listener);
+	}
+}
+
+//--------------------------------------------------------------
+void ofxEventRouter::clear() {
+	for(int i = 0; i < ofxInputEvent::NUM_TYPES; ++i) {
+		std::vector<Subscriber>& list = _subscribers[i];
+		for(unsigned int j = 0; j < list.size(); ++j) {
+			delete list[j].delegate;
+		}
+		list.clear();
+	}
+}
+
+/* ***** PROTECTED ***** */
+
+//--------------------------------------------------------------
+void ofxEventRouter::insert(ofxInputEvent::Type type, void* listener,
+                            DelegateBase* delegate, int priority) {
+	if(type >= ofxInputEvent::NUM_TYPES || listener == NULL) {
+		ofLogWarning("ofxEventRouter") << "cannot add NULL listener or unknown event type";
+		delete delegate;
+		return;
+	}
+
+	// insert after all subscribers with the same or higher priority
+	std::vector<Subscriber>& list = _subscribers[type];
+	std::vector<Subscriber>::iterator iter = list.begin();
+	while(iter != list.end() && iter->priority >= priority) {
+		++iter;
+	}
+	Subscriber s;
+	s.priority = priority;
+	s.listener = listener;
+	s.delegate = delegate;
+	list.insert(iter, s);
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#pragma once
+
+#include <vector>
+
+#include "ofxInputQueue.h"
+
+/**
+	\class  EventRouter
+	\brief  dispatches input events to subscribed handler methods
+
+	each event type has its own subscriber list sorted by priority (highest
+	first), only the methods which are actually subscribed are called and
+	event types nobody listens to cost nothing beyond an empty check
+
+	handlers either return void or bool, returning true consumes the
+	event and stops propagation:
+
+	    router.add(ofxInputEvent::MOUSE_PRESSED, this, &MyScene::pressed, 10);
+	    ...
+	    bool MyScene::pressed(const ofxInputEvent& event) {
+	        return button.inside(event.x, event.y); // consume if hit
+	    }
+
+	note: do not add or remove subscribers from within a handler
+**/
+class ofxEventRouter {
+	public:
+
+		ofxEventRouter() {}
+		virtual ~ofxEventRouter() {
+			clear();
+		}
+
+	/// \section Subscribing
+
+		/// subscribe a consuming handler to an event type,
+		/// higher priorities are called first, equal priorities are called
+		/// in the order they were added
+		template <class T>
+		void add(ofxInputEvent::Type type, T* listener,
+		         bool (T::*method)(const ofxInputEvent&), int priority=0) {
+			insert(type, listener, new ConsumingDelegate<T>(listener, method), priority);
+		}
+
+		/// subscribe a non-consuming handler to an event type
+		template <class T>
+		void add(ofxInputEvent::Type type, T* listener,
+		         void (T::*method)(const ofxInputEvent&), int priority=0) {
+			insert(type, listener, new Delegate<T>(listener, method), priority);
+		}
+
+		/// unsubscribe all of a listener's handlers for an event type
+		void remove(ofxInputEvent::Type type, void* listener);
+
+		/// unsubscribe all of a listener's handlers
+		void remove(void* listener);
+
+		/// unsubscribe everything
+		void clear();
+
+		/// does an event type have any subscribers?
+		inline bool hasSubscribers(ofxInputEvent::Type type) {
+			return type < ofxInputEvent::NUM_TYPES && !_subscribers[type].empty();
+		}
+
+	/// \section Dispatch
+
+		/// send an event to the subscribers of its type in priority order,
+		/// returns true if the event was consumed
+		inline bool dispatch(const ofxInputEvent& event) {
+			if(event.type >= ofxInputEvent::NUM_TYPES || _subscribers[event.type].empty())
+				return false;
+			std::vector<Subscriber>& list = _subscribers[event.type];
+			for(unsigned int i = 0; i < list.size(); ++i) {
+				if(list[i].delegate->call(event))
+					return true;
+			}
+			return false;
+		}
+
+	protected:
+
+		/// type erased handler call
+		class DelegateBase {
+			public:
+				virtual ~DelegateBase() {}
+				virtual bool call(const ofxInputEvent& event) = 0;
+		};
+
+		template <class T>
+		class Delegate : public DelegateBase {
+			public:
+				Delegate(T* listener, void (T::*method)(const ofxInputEvent&)) :
+					listener(listener), method(method) {}
+				bool call(const ofxInputEvent& event) {
+					(listener->*method)(event);
+					return false;
+				}
+				T* listener;
+				void (T::*method)(const ofxInputEvent&);
+		};
+
+		template <class T>
+		class ConsumingDelegate : public DelegateBase {
+			public:
+				ConsumingDelegate(T* listener, bool (T::*method)(const ofxInputEvent&)) :
+					listener(listener), method(method) {}
+				bool call(const ofxInputEvent& event) {
+					return (listener->*method)(event);
+				}
+				T* listener;
+				bool (T::*method)(const ofxInputEvent&);
+		};
+
+		/// a subscribed handler
+		struct Subscriber {
+			int priority;
+			void* listener;         ///< used for removal
+			DelegateBase* delegate; ///< owned by the router
+		};
+
+		/// add a delegate to the list, keeps the list sorted by priority
+		void insert(ofxInputEvent::Type type, void* listener, DelegateBase* delegate, int priority);
+
+		std::vector<Subscriber> _subscribers[ofxInputEvent::NUM_TYPES]; ///< per type lists
+
+	private:
+
+		ofxEventRouter(ofxEventRouter const&) {} // not copyable, owns the delegates
+		ofxEventRouter& operator=(ofxEventRouter& from) {return *this;} // not assignable
+};
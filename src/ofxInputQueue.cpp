@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#include "ofxInputQueue.h"
+
+/// INPUT QUEUE
+
+//--------------------------------------------------------------
+ofxInputQueue::ofxInputQueue() : _bKeepHistory(false), _bDispatching(false),
+	_received(0), _numReceived(0), _numDispatched(0) {
+	for(int i = 0; i < ofxInputEvent::NUM_TYPES; ++i) {
+		_receivedCounts[i] = 0;
+		_typeCounts[i] = 0;
+	}
+}
+
+//--------------------------------------------------------------
+// only look back through the trailing run of motion events so a move is never
+// coalesced across a press, release, or key event
+void ofxInputQueue::push(const ofxInputEvent& event) {
+
+	_received++;
+	if(event.type < ofxInputEvent::NUM_TYPES)
+		_receivedCounts[event.type]++;
+	if(_bKeepHistory)
+		_pendingHistory.push_back(event);
+
+	if(event.isMotion()) {
+		for(int i = (int) _events.size()-1; i >= 0 && _events[i].isMotion(); --i) {
+			ofxInputEvent& e = _events[i];
+			if(e.type != event.type)
+				continue;
+			bool same = false;
+			switch(event.type) {
+				case ofxInputEvent::MOUSE_MOVED:
+					same = true; break;
+				case ofxInputEvent::MOUSE_DRAGGED:
+					same = (e.button == event.button); break;
+			#ifdef TARGET_OF_IPHONE
+				case ofxInputEvent::TOUCH_MOVED:
+					same = (e.touch.id == event.touch.id); break;
+			#endif
+				default:
+					break;
+			}
+			if(same) {
+				e = event; // replace with the latest
+				return;
+			}
+		}
+	}
+	_events.push_back(event);
+}
+
+//--------------------------------------------------------------
+void ofxInputQueue::clear() {
+	_events.clear();
+	_pendingHistory.clear();
+	_received = 0;
+	for(int i = 0; i < ofxInputEvent::NUM_TYPES; ++i) {
+		_receivedCounts[i] = 0;
+	}
+}
+
+/* ***** PROTECTED ***** */
+
+//--------------------------------------------------------------
+void ofxInputQueue::finishFrame() {
+	_numReceived = _received;
+	_numDispatched = _events.size();
+	for(int i = 0; i < ofxInputEvent::NUM_TYPES; ++i) {
+		_typeCounts[i] = _receivedCounts[i];
+	}
+	_history.swap(_pendingHistory); // keep the allocated memory around
+	clear();
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#pragma once
+
+#include <vector>
+
+#include "ofConstants.h"
+#include "ofEvents.h"
+
+/**
+	\class  InputEvent
+	\brief  a single key, mouse, or touch input event
+**/
+class ofxInputEvent {
+	public:
+
+		/// event types
+		enum Type {
+			KEY_PRESSED = 0,
+			KEY_RELEASED,
+			MOUSE_MOVED,
+			MOUSE_DRAGGED,
+			MOUSE_PRESSED,
+			MOUSE_RELEASED,
+			TOUCH_DOWN,
+			TOUCH_MOVED,
+			TOUCH_UP,
+			TOUCH_DOUBLE_TAP,
+			TOUCH_CANCELLED,
+			NUM_TYPES
+		};
+
+		ofxInputEvent(Type type=KEY_PRESSED) :
+			type(type), key(0), x(0), y(0), button(0) {}
+
+		/// key event
+		ofxInputEvent(Type type, int key) :
+			type(type), key(key), x(0), y(0), button(0) {}
+
+		/// mouse event
+		ofxInputEvent(Type type, int x, int y, int button=0) :
+			type(type), key(0), x(x), y(y), button(button) {}
+
+	#ifdef TARGET_OF_IPHONE
+		/// touch event
+		ofxInputEvent(Type type, const ofTouchEventArgs& touch) :
+			type(type), key(0), x(touch.x), y(touch.y), button(0), touch(touch) {}
+	#endif
+
+		/// is this a mouse move/drag or touch move event?
+		inline bool isMotion() const {
+			return type == MOUSE_MOVED || type == MOUSE_DRAGGED || type == TOUCH_MOVED;
+		}
+
+		Type type;  ///< event type
+		int key;    ///< key for key events
+		int x, y;   ///< position for mouse events
+		int button; ///< mouse button for mouse drag/press/release events
+
+	#ifdef TARGET_OF_IPHONE
+		ofTouchEventArgs touch; ///< touch args for touch events
+	#endif
+};
+
+/**
+	\class  InputQueue
+	\brief  collects input events between frames and dispatches them in a batch
+
+	consecutive move & drag events are coalesced so only the latest position
+	is dispatched, set keepHistory if you need every event received
+**/
+class ofxInputQueue {
+	public:
+
+		ofxInputQueue();
+
+	/// \section Queue
+
+		/// add an event, coalesces redundant move/drag events
+		void push(const ofxInputEvent& event);
+
+		/// dispatch all queued events to a target with the usual ofBaseApp
+		/// callbacks (keyPressed, mouseMoved, etc) & clear the queue
+		///
+		/// the event counts are updated for this frame
+		template <class T>
+		void dispatch(T& target) {
+			_bDispatching = true;
+			for(unsigned int i = 0; i < _events.size(); ++i) {
+				ofxInputEvent& e = _events[i];
+				switch(e.type) {
+					case ofxInputEvent::KEY_PRESSED:
+						target.keyPressed(e.key); break;
+					case ofxInputEvent::KEY_RELEASED:
+						target.keyReleased(e.key); break;
+					case ofxInputEvent::MOUSE_MOVED:
+						target.mouseMoved(e.x, e.y); break;
+					case ofxInputEvent::MOUSE_DRAGGED:
+						target.mouseDragged(e.x, e.y, e.button); break;
+					case ofxInputEvent::MOUSE_PRESSED:
+						target.mousePressed(e.x, e.y, e.button); break;
+					case ofxInputEvent::MOUSE_RELEASED:
+						target.mouseReleased(e.x, e.y, e.button); break;
+				#ifdef TARGET_OF_IPHONE
+					case ofxInputEvent::TOUCH_DOWN:
+						target.touchDown(e.touch); break;
+					case ofxInputEvent::TOUCH_MOVED:
+						target.touchMoved(e.touch); break;
+					case ofxInputEvent::TOUCH_UP:
+						target.touchUp(e.touch); break;
+					case ofxInputEvent::TOUCH_DOUBLE_TAP:
+						target.touchDoubleTap(e.touch); break;
+					case ofxInputEvent::TOUCH_CANCELLED:
+						target.touchCancelled(e.touch); break;
+				#endif
+					default:
+						break;
+				}
+			}
+			_bDispatching = false;
+			finishFrame();
+		}
+
+		/// is the queue currently dispatching?
+		/// use this to avoid re-queueing events while they are dispatched
+		inline bool isDispatching() {return _bDispatching;}
+
+		/// discard all queued events
+		void clear();
+
+		/// number of events currently queued
+		inline unsigned int size() {return _events.size();}
+		inline bool empty()        {return _events.empty();}
+
+	/// \section History
+
+		/// keep every received event, including the coalesced ones? (off by default)
+		void setKeepHistory(bool keep) {_bKeepHistory = keep;}
+		bool getKeepHistory()          {return _bKeepHistory;}
+
+		/// all events received during the last dispatched frame,
+		/// empty if keepHistory is off
+		const std::vector<ofxInputEvent>& getHistory() {return _history;}
+
+	/// \section Stats (for the last dispatched frame)
+
+		/// total number of events received
+		unsigned int getNumReceived()   {return _numReceived;}
+
+		/// number of events dispatched after coalescing
+		unsigned int getNumDispatched() {return _numDispatched;}
+
+		/// number of events dropped by coalescing
+		unsigned int getNumCoalesced()  {return _numReceived - _numDispatched;}
+
+		/// number of events received of a given type
+		unsigned int getNumReceived(ofxInputEvent::Type type) {
+			return type < ofxInputEvent::NUM_TYPES ? _typeCounts[type] : 0;
+		}
+
+	protected:
+
+		/// do the stats & swap the buffers
+		void finishFrame();
+
+		std::vector<ofxInputEvent> _events;         ///< queued events
+		std::vector<ofxInputEvent> _history;        ///< last frame's received events
+		std::vector<ofxInputEvent> _pendingHistory; ///< this frame's received events
+		bool _bKeepHistory; ///< keep the received events?
+		bool _bDispatching; ///< are events being dispatched?
+
+		unsigned int _received; ///< events received this frame
+		unsigned int _receivedCounts[ofxInputEvent::NUM_TYPES];
+
+		unsigned int _numReceived, _numDispatched; ///< last frame stats
+		unsigned int _typeCounts[ofxInputEvent::NUM_TYPES];
+};
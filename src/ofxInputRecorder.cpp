@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#include "ofxInputRecorder.h"
+
+#include "ofUtils.h"
+
+// file id & version, written at the beginning of the log
+static const char LOG_MAGIC[4] = {'O', 'F', 'X', 'I'};
+static const unsigned int LOG_VERSION = 1;
+
+/// INPUT RECORDER
+
+//--------------------------------------------------------------
+ofxInputRecorder::ofxInputRecorder() :
+	_bRecording(false), _bReplaying(false), _bRealtime(false),
+	_readPos(0), _bPending(false), _frame(0), _startMS(0),
+	_numEvents(0), _lastScene(-1) {}
+
+//--------------------------------------------------------------
+ofxInputRecorder::~ofxInputRecorder() {
+	stopRecording();
+}
+
+//--------------------------------------------------------------
+bool ofxInputRecorder::startRecording(const string file) {
+	stopRecording();
+	stopReplay();
+
+	_file.open(ofToDataPath(file).c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+	if(!_file.is_open()) {
+		ofLogError("ofxInputRecorder") << "could not open \"" << file << "\" for recording";
+		return false;
+	}
+	_file.write(LOG_MAGIC, 4);
+	write(LOG_VERSION);
+
+	_bRecording = true;
+	_frame = 0;
+	_startMS = ofGetElapsedTimeMillis();
+	_numEvents = 0;
+	_lastScene = -1;
+	ofLogVerbose("ofxInputRecorder") << "recording to \"" << file << "\"";
+	return true;
+}
+
+void ofxInputRecorder::stopRecording() {
+	if(!_bRecording)
+		return;
+	_file.close();
+	_bRecording = false;
+	ofLogVerbose("ofxInputRecorder") << "recorded " << _numEvents
+		<< " events over " << _frame << " frames";
+}
+
+//--------------------------------------------------------------
+void ofxInputRecorder::recordInput(const ofxInputEvent& event) {
+	if(!_bRecording)
+		return;
+	writeHeader(event.type);
+	switch(event.type) {
+		case ofxInputEvent::KEY_PRESSED:
+		case ofxInputEvent::KEY_RELEASED:
+			write(event.key);
+			break;
+		case ofxInputEvent::MOUSE_MOVED:
+			write(event.x);
+			write(event.y);
+			break;
+		case ofxInputEvent::MOUSE_DRAGGED:
+		case ofxInputEvent::MOUSE_PRESSED:
+		case ofxInputEvent::MOUSE_RELEASED:
+			write(event.x);
+			write(event.y);
+			write(event.button);
+			break;
+		default: // touch
+		#ifdef TARGET_OF_IPHONE
+			write(event.touch.id);
+			write(event.touch.numTouches);
+			write(event.touch.x);
+			write(event.touch.y);
+		#endif
+			break;
+	}
+}
+
+void ofxInputRecorder::recordResize(int w, int h) {
+	if(!_bRecording)
+		return;
+	writeHeader(WINDOW_RESIZED);
+	write(w);
+	write(h);
+}
+
+void ofxInputRecorder::recordDrag(const ofDragInfo& dragInfo) {
+	if(!_bRecording)
+		return;
+	writeHeader(DRAG_EVENT);
+	write(dragInfo.position.x);
+	write(dragInfo.position.y);
+	write((unsigned int) dragInfo.files.size());
+	for(unsigned int i = 0; i < dragInfo.files.size(); ++i) {
+		writeString(dragInfo.files[i]);
+	}
+}
+
+void ofxInputRecorder::recordMessage(const ofMessage& msg) {
+	if(!_bRecording)
+		return;
+	writeHeader(GOT_MESSAGE);
+	writeString(msg.message);
+}
+
+void ofxInputRecorder::recordScene(int scene) {
+	if(!_bRecording || scene == _lastScene)
+		return;
+	writeHeader(SCENE_CHANGED);
+	write(scene);
+	_lastScene = scene;
+}
+
+//--------------------------------------------------------------
+bool ofxInputRecorder::startReplay(const string file, bool realtime) {
+	stopRecording();
+	stopReplay();
+
+	_log = ofBufferFromFile(file, true);
+	char magic[4] = {0, 0, 0, 0};
+	unsigned int version = 0;
+	_readPos = 0;
+	if(!read(magic) || memcmp(magic, LOG_MAGIC, 4) != 0 ||
+	   !read(version) || version != LOG_VERSION) {
+		ofLogError("ofxInputRecorder") << "\"" << file << "\" is not a valid input log";
+		_log.clear();
+		return false;
+	}
+
+	_bReplaying = true;
+	_bRealtime = realtime;
+	_bPending = false;
+	_frame = 0;
+	_startMS = ofGetElapsedTimeMillis();
+	_numEvents = 0;
+	ofLogVerbose("ofxInputRecorder") << "replaying \"" << file << "\""
+		<< (realtime ? " in real time" : "");
+	return true;
+}
+
+void ofxInputRecorder::stopReplay() {
+	if(!_bReplaying)
+		return;
+	_log.clear();
+	_readPos = 0;
+	_bPending = false;
+	_bReplaying = false;
+	ofLogVerbose("ofxInputRecorder") << "replayed " << _numEvents
+		<< " events over " << _frame << " frames";
+}
+
+//--------------------------------------------------------------
+bool ofxInputRecorder::nextEvent(Event& event) {
+	if(!_bReplaying)
+		return false;
+
+	if(!_bPending) {
+		if(_readPos >= _log.size())
+			return false; // done
+		if(!readEvent(_pending)) {
+			ofLogWarning("ofxInputRecorder") << "truncated input log, stopping replay";
+			_readPos = _log.size();
+			return false;
+		}
+		_bPending = true;
+	}
+
+	// not due yet? events are stamped with the frame they arrived in,
+	// after that frame's update, so they're due once the next frame begins
+	if(_bRealtime ? _pending.time > getTime() : _pending.frame >= _frame)
+		return false;
+
+	event = _pending;
+	_bPending = false;
+	_numEvents++;
+	return true;
+}
+
+//--------------------------------------------------------------
+void ofxInputRecorder::beginFrame() {
+	if(_bRecording || _bReplaying)
+		_frame++;
+}
+
+unsigned int ofxInputRecorder::getTime() {
+	return ofGetElapsedTimeMillis() - _startMS;
+}
+
+/* ***** PROTECTED ***** */
+
+//--------------------------------------------------------------
+void ofxInputRecorder::writeHeader(unsigned char type) {
+	write(type);
+	write(_frame);
+	write(getTime());
+	_numEvents++;
+}
+
+void ofxInputRecorder::writeString(const string& s) {
+	write((unsigned int) s.size());
+	_file.write(s.c_str(), s.size());
+}
+
+//--------------------------------------------------------------
+bool ofxInputRecorder::readString(string& s) {
+	unsigned int size = 0;
+	if(!read(size) || _readPos + size > (unsigned long) _log.size())
+		return false;
+	s.assign(_log.getBinaryBuffer() + _readPos, size);
+	_readPos += size;
+	return true;
+}
+
+bool ofxInputRecorder::readEvent(Event& event) {
+	event = Event();
+	if(!read(event.type) || !read(event.frame) || !read(event.time))
+		return false;
+
+	if(event.type < ofxInputEvent::NUM_TYPES) {
+		event.input.type = (ofxInputEvent::Type) event.type;
+		switch(event.input.type) {
+			case ofxInputEvent::KEY_PRESSED:
+			case ofxInputEvent::KEY_RELEASED:
+				return read(event.input.key);
+			case ofxInputEvent::MOUSE_MOVED:
+				return read(event.input.x) && read(event.input.y);
+			case ofxInputEvent::MOUSE_DRAGGED:
+			case ofxInputEvent::MOUSE_PRESSED:
+			case ofxInputEvent::MOUSE_RELEASED:
+				return read(event.input.x) && read(event.input.y) &&
+				       read(event.input.button);
+			default: // touch
+			#ifdef TARGET_OF_IPHONE
+				if(!read(event.input.touch.id) || !read(event.input.touch.numTouches) ||
+				   !read(event.input.touch.x) || !read(event.input.touch.y))
+					return false;
+				event.input.x = event.input.touch.x;
+				event.input.y = event.input.touch.y;
+			#endif
+				return true;
+		}
+	}
+
+	switch(event.type) {
+		case WINDOW_RESIZED:
+			return read(event.width) && read(event.height);
+		case DRAG_EVENT: {
+			unsigned int numFiles = 0;
+			if(!read(event.dragInfo.position.x) || !read(event.dragInfo.position.y) ||
+			   !read(numFiles))
+				return false;
+			for(unsigned int i = 0; i < numFiles; ++i) {
+				string file;
+				if(!readString(file))
+					return false;
+				event.dragInfo.files.push_back(file);
+			}
+			return true;
+		}
+		case GOT_MESSAGE:
+			return readString(event.message);
+		case SCENE_CHANGED:
+			return read(event.scene);
+		default:
+			ofLogWarning("ofxInputRecorder") << "unknown event type " << (int) event.type;
+			return false;
+	}
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#pragma once
+
+#include <fstream>
+
+#include "ofConstants.h"
+#include "ofTypes.h"
+#include "ofFileUtils.h"
+
+#include "ofxInputQueue.h"
+
+/**
+	\class  InputRecorder
+	\brief  records app callbacks with frame clock timestamps & replays them
+
+	the log is a compact binary file with one record per event:
+	type (1 byte), frame (4 bytes), ms since start (4 bytes), & the event data
+
+	replay either runs frame by frame at full speed (events are fed back
+	on the same frame number they were recorded on) or in real time (events
+	are fed back once their recorded time has passed)
+
+	note: the log is written in host byte order
+**/
+class ofxInputRecorder {
+	public:
+
+		/// recorded event types, the input types match ofxInputEvent::Type
+		enum EventType {
+			WINDOW_RESIZED = ofxInputEvent::NUM_TYPES,
+			DRAG_EVENT,
+			GOT_MESSAGE,
+			SCENE_CHANGED,
+			NUM_EVENT_TYPES
+		};
+
+		/// a recorded event
+		struct Event {
+			unsigned char type; ///< ofxInputEvent::Type or EventType
+			unsigned int frame; ///< frame number since start
+			unsigned int time;  ///< ms since start
+			ofxInputEvent input;  ///< input event data
+			int width, height;    ///< window size for WINDOW_RESIZED
+			ofDragInfo dragInfo;  ///< DRAG_EVENT info
+			string message;       ///< GOT_MESSAGE text
+			int scene;            ///< scene index for SCENE_CHANGED
+			Event() : type(0), frame(0), time(0), width(0), height(0), scene(-1) {}
+		};
+
+		ofxInputRecorder();
+		virtual ~ofxInputRecorder();
+
+	/// \section Recording
+
+		/// start/stop recording to a file in the data folder,
+		/// any current recording or replay is stopped
+		bool startRecording(const string file="inputLog.bin");
+		void stopRecording();
+		inline bool isRecording() {return _bRecording;}
+
+		/// record events, ignored when not recording
+		void recordInput(const ofxInputEvent& event);
+		void recordResize(int w, int h);
+		void recordDrag(const ofDragInfo& dragInfo);
+		void recordMessage(const ofMessage& msg);
+
+		/// record the current scene index, only written when it changes,
+		/// used to check that a replay follows the recording
+		void recordScene(int scene);
+
+	/// \section Replay
+
+		/// start/stop replaying a file in the data folder,
+		/// set realtime to true to feed events back at their recorded times
+		/// instead of their recorded frame numbers
+		///
+		/// any current recording or replay is stopped
+		bool startReplay(const string file="inputLog.bin", bool realtime=false);
+		void stopReplay();
+		inline bool isReplaying() {return _bReplaying;}
+
+		/// have all of the events been replayed?
+		inline bool isReplayDone() {return _bReplaying && _readPos >= _log.size();}
+
+		/// get the next event due in the current frame,
+		/// returns false when there are no more events for this frame
+		///
+		/// events arrive between updates & are stamped with the frame of the
+		/// last beginFrame(), so an event recorded on frame N is returned
+		/// after the beginFrame() that starts frame N+1: the same place it
+		/// arrived in live, before the next update
+		bool nextEvent(Event& event);
+
+	/// \section Frame Clock
+
+		/// advance the frame clock, call this once at the beginning of each
+		/// frame (done automatically by ofxApp)
+		void beginFrame();
+
+		/// current frame & ms since the recording or replay started
+		inline unsigned int getFrame() {return _frame;}
+		unsigned int getTime();
+
+		/// number of events recorded or replayed so far
+		inline unsigned int getNumEvents() {return _numEvents;}
+
+	protected:
+
+		/// write the common header & the event payload
+		void writeHeader(unsigned char type);
+		template <class T>
+		void write(const T& value) {
+			_file.write((const char*) &value, sizeof(T));
+		}
+		void writeString(const string& s);
+
+		/// read values from the replay log, returns false on a truncated log
+		template <class T>
+		bool read(T& value) {
+			if(_readPos + sizeof(T) > _log.size())
+				return false;
+			memcpy(&value, _log.getBinaryBuffer() + _readPos, sizeof(T));
+			_readPos += sizeof(T);
+			return true;
+		}
+		bool readString(string& s);
+
+		/// read the next whole event, returns false on a truncated log
+		bool readEvent(Event& event);
+
+		bool _bRecording, _bReplaying, _bRealtime;
+		std::ofstream _file;         ///< log file when recording
+		ofBuffer _log;               ///< whole log when replaying
+		unsigned long _readPos;      ///< replay read position
+		bool _bPending;              ///< is an event waiting for its frame?
+		Event _pending;              ///< next event to be replayed
+
+		unsigned int _frame;         ///< frames since start
+		unsigned long long _startMS; ///< elapsed ms at start
+		unsigned int _numEvents;     ///< events handled so far
+		int _lastScene;              ///< last recorded scene index
+};
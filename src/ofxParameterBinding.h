@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#pragma once
+
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include "ofConstants.h"
+
+#ifdef OFX_APP_UTILS_USE_CONTROL_PANEL
+	#include "ofxControlPanel.h"
+#endif
+
+class ofxBoundParameterBase;
+
+/**
+	\class  ParameterListener
+	\brief  receives change notifications from bound parameters
+**/
+class ofxParameterListener {
+	public:
+		virtual ~ofxParameterListener() {}
+
+		/// called whenever a bound parameter's value changes
+		virtual void parameterChanged(ofxBoundParameterBase& param) = 0;
+};
+
+/**
+	\class  BoundParameterBase
+	\brief  untyped base for a parameter with a dirty flag & change listeners
+**/
+class ofxBoundParameterBase {
+	public:
+
+		ofxBoundParameterBase(const std::string name="") :
+			_name(name), _bDirty(false) {}
+		virtual ~ofxBoundParameterBase() {}
+
+		/// re-read the value from the bound source (if any),
+		/// marks the parameter dirty & notifies listeners if it changed
+		///
+		/// returns true if the value changed
+		virtual bool sync() {return false;}
+
+		/// has the value changed since the dirty flag was last cleared?
+		inline bool isDirty()     {return _bDirty;}
+		inline void clearDirty()  {_bDirty = false;}
+
+		/// add/remove a change listener
+		void addListener(ofxParameterListener* listener) {
+			if(listener != NULL && std::find(_listeners.begin(), _listeners.end(), listener) == _listeners.end())
+				_listeners.push_back(listener);
+		}
+		void removeListener(ofxParameterListener* listener) {
+			_listeners.erase(std::remove(_listeners.begin(), _listeners.end(), listener), _listeners.end());
+		}
+
+		/// get/set the name, used for identification only
+		inline void setName(const std::string name) {_name = name;}
+		inline const std::string& getName()         {return _name;}
+
+	protected:
+
+		/// set dirty & notify the listeners
+		void changed() {
+			_bDirty = true;
+			for(unsigned int i = 0; i < _listeners.size(); ++i) {
+				_listeners[i]->parameterChanged(*this);
+			}
+		}
+
+	private:
+
+		std::string _name; ///< parameter name
+		bool _bDirty;      ///< has the value changed?
+		std::vector<ofxParameterListener*> _listeners; ///< change listeners
+};
+
+/**
+	\class  BoundParameter
+	\brief  a typed parameter which can be bound to a resolved control handle
+
+	when bound, the control is read directly through the handle instead of
+	looking it up by name every frame:
+
+	    ofxBoundParameter<float> speed(1.0, "speed");
+	    speed.bind(controlPanel.addSlider("speed", "speed", 1.0, 0, 10, false));
+	    ...
+	    if(speed.sync()) { // only true when the slider moved
+	        recalc(speed.get());
+	    }
+**/
+template <class T>
+class ofxBoundParameter : public ofxBoundParameterBase {
+	public:
+
+		ofxBoundParameter(const T& value=T(), const std::string name="") :
+			ofxBoundParameterBase(name), _value(value)
+		#ifdef OFX_APP_UTILS_USE_CONTROL_PANEL
+			, _control(NULL), _which(0)
+		#endif
+			{}
+
+		/// get the current value
+		inline const T& get() const {return _value;}
+		inline operator const T&() const {return _value;}
+
+		/// set the value, pushes the value to the bound control (if any),
+		/// marks dirty & notifies the listeners if the value changed
+		void set(const T& value) {
+			if(value == _value)
+				return;
+			_value = value;
+		#ifdef OFX_APP_UTILS_USE_CONTROL_PANEL
+			if(_control != NULL)
+				_control->setValue((float) _value, _which);
+		#endif
+			changed();
+		}
+		ofxBoundParameter& operator=(const T& value) {
+			set(value);
+			return *this;
+		}
+
+	#ifdef OFX_APP_UTILS_USE_CONTROL_PANEL
+
+		/// bind to a control panel gui object, which is the value index
+		/// for multi value controls (ie 0 = x & 1 = y for a 2D slider)
+		///
+		/// the current control value is taken over without marking dirty,
+		/// set control to NULL to unbind
+		void bind(guiBaseObject* control, int which=0) {
+			_control = control;
+			_which = which;
+			if(_control != NULL)
+				read(_value);
+		}
+		inline bool isBound() {return _control != NULL;}
+
+		/// read the bound control
+		bool sync() {
+			if(_control == NULL)
+				return false;
+			T value;
+			read(value);
+			if(value == _value)
+				return false;
+			_value = value;
+			changed();
+			return true;
+		}
+
+	private:
+
+		inline void read(float& value) {value = _control->value.getValueF(_which);}
+		inline void read(bool& value)  {value = _control->value.getValueB(_which);}
+		inline void read(int& value)   {value = _control->value.getValueI(_which);}
+
+		guiBaseObject* _control; ///< bound control handle
+		int _which;              ///< control value index
+
+	#endif
+
+	private:
+
+		T _value; ///< current value
+};
+
+/**
+	\class  ParameterGroup
+	\brief  a list of bound parameters to sync & clear together
+
+	note: does not own the parameters
+**/
+class ofxParameterGroup {
+	public:
+
+		/// add/remove a parameter
+		void add(ofxBoundParameterBase& param) {
+			if(std::find(_params.begin(), _params.end(), &param) == _params.end())
+				_params.push_back(&param);
+		}
+		void remove(ofxBoundParameterBase& param) {
+			_params.erase(std::remove(_params.begin(), _params.end(), &param), _params.end());
+		}
+		void clear() {_params.clear();}
+
+		/// sync all parameters with their bound sources,
+		/// returns true if any parameter is dirty
+		bool sync() {
+			bool dirty = false;
+			for(unsigned int i = 0; i < _params.size(); ++i) {
+				_params[i]->sync();
+				dirty |= _params[i]->isDirty();
+			}
+			return dirty;
+		}
+
+		/// is any parameter dirty?
+		bool isDirty() {
+			for(unsigned int i = 0; i < _params.size(); ++i) {
+				if(_params[i]->isDirty())
+					return true;
+			}
+			return false;
+		}
+
+		/// clear all dirty flags
+		void clearDirty() {
+			for(unsigned int i = 0; i < _params.size(); ++i) {
+				_params[i]->clearDirty();
+			}
+		}
+
+		/// add a listener to all current parameters
+		void addListener(ofxParameterListener* listener) {
+			for(unsigned int i = 0; i < _params.size(); ++i) {
+				_params[i]->addListener(listener);
+			}
+		}
+
+		inline unsigned int size() {return _params.size();}
+		inline bool empty()        {return _params.empty();}
+
+	private:
+
+		std::vector<ofxBoundParameterBase*> _params; ///< parameters
+};
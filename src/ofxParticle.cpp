@@ -13,25 +13,29 @@
 unsigned int ofxParticle::_frameTimeout = 500;
 
 //--------------------------------------------------------------
-ofxParticle::ofxParticle() : ofRectangle(), bAlive(false), lifespan(0), age(0) {
+ofxParticle::ofxParticle() : ofRectangle(), bAlive(false), lifespan(0), age(0), id(0), trail(ofxParticleTrails::NO_SLOT),
+	randomSeed(0), randomFrame(0) {
 	reset();
 }
 
 //--------------------------------------------------------------
 ofxParticle::ofxParticle(float x, float y, float w, float h) :
-	ofRectangle(x, y, w, h), bAlive(false), lifespan(0), age(0) {
+	ofRectangle(x, y, w, h), bAlive(false), lifespan(0), age(0), id(0), trail(ofxParticleTrails::NO_SLOT),
+	randomSeed(0), randomFrame(0) {
 	reset();
 }
 
 //--------------------------------------------------------------
 ofxParticle::ofxParticle(ofPoint pos, float w, float h) : 
-	ofRectangle(pos.x, pos.y, w, h), bAlive(false), lifespan(0), age(0) {
+	ofRectangle(pos.x, pos.y, w, h), bAlive(false), lifespan(0), age(0), id(0), trail(ofxParticleTrails::NO_SLOT),
+	randomSeed(0), randomFrame(0) {
 	reset();
 }
 		
 //--------------------------------------------------------------
 ofxParticle::ofxParticle(ofRectangle rect) : 
-	ofRectangle(rect), bAlive(false), lifespan(0), age(0) {
+	ofRectangle(rect), bAlive(false), lifespan(0), age(0), id(0), trail(ofxParticleTrails::NO_SLOT),
+	randomSeed(0), randomFrame(0) {
 	reset();
 }
 
@@ -49,6 +53,11 @@ ofxParticle& ofxParticle::operator=(const ofxParticle& from) {
 	bAlive = from.bAlive;
 	lifespan = from.lifespan;
 	age = from.age;
+	id = from.id;
+	trail = from.trail;
+	randomSeed = from.randomSeed;
+	randomFrame = from.randomFrame;
+	lifeTimer = from.lifeTimer; // keep aging from the same frame time
 	return *this;
 }
 
@@ -80,3 +89,30 @@ double ofxParticle::getAgeN() {
 double ofxParticle::getRemainingLifeN() {
 	return ((getAgeN()*-1.0) + 1.0);
 }
+
+//--------------------------------------------------------------
+void ofxParticle::save(ofxParticleSnapshot& snapshot) {
+	snapshot.write(x);
+	snapshot.write(y);
+	snapshot.write(width);
+	snapshot.write(height);
+	snapshot.write(bAlive);
+	snapshot.write(lifespan);
+	snapshot.write(age);
+	snapshot.write(id);
+}
+
+//--------------------------------------------------------------
+bool ofxParticle::load(ofxParticleSnapshot& snapshot) {
+	snapshot.read(x);
+	snapshot.read(y);
+	snapshot.read(width);
+	snapshot.read(height);
+	snapshot.read(bAlive);
+	snapshot.read(lifespan);
+	snapshot.read(age);
+	snapshot.read(id);
+	lifeTimer.set(); // age from now
+	trail = ofxParticleTrails::NO_SLOT;
+	return snapshot.isGood();
+}
@@ -13,6 +13,17 @@
 #include "ofxTimer.h"
 #include "ofRectangle.h"
 
+#include "ofxParticleRandom.h"
+#include "ofxParticleTrails.h"
+#include "ofxParticleSnapshot.h"
+
+/// per particle attributes for batched drawing, see ofxParticleBatch
+struct ofxParticleInstance {
+	float x, y, width, height; ///< rect, from the ofRectangle base by default
+	float r, g, b, a;          ///< color, 0-1
+	float age;                 ///< normalized age, 0 is birth, 1 is death
+};
+
 /**
 	\class  Particle
 	\brief  a particle with a lifespan
@@ -49,6 +60,26 @@ class ofxParticle : public ofRectangle {
 		/// draw
 		virtual void draw() = 0;
 
+		/// fill the attributes used when the particle manager draws in a batch
+		/// instead of calling draw(), the default uses the rect, opaque white,
+		/// & the normalized age
+		///
+		/// note: may be called from multiple threads at once, only read the
+		///       particle state here
+		virtual void fillInstance(ofxParticleInstance& instance) {
+			instance.x = x;
+			instance.y = y;
+			instance.width = width;
+			instance.height = height;
+			instance.r = instance.g = instance.b = instance.a = 1;
+			instance.age = getAgeN();
+		}
+
+
+		/// the key used when the particle manager draws in key order, lower
+		/// keys are drawn first (behind), ie a depth or layer, default 0
+		virtual float getDrawKey() {return 0;}
+
 
 	/// \section Status
 
@@ -74,8 +105,47 @@ class ofxParticle : public ofRectangle {
 		inline void kill()  {bAlive = false; age = 0;}
 
 
+	/// \section Snapshot
+
+		/// the type written to snapshots, the manager's createParticle()
+		/// gets this type back when restoring, return a different type for
+		/// each particle class you want to restore (default 0)
+		virtual unsigned int getSnapshotType() {return 0;}
+
+		/// write the particle state to a snapshot, override to add your own
+		/// state after calling this
+		virtual void save(ofxParticleSnapshot& snapshot);
+
+		/// read the particle state from a snapshot in the same order as
+		/// save(), returns false if the snapshot ran out of data
+		virtual bool load(ofxParticleSnapshot& snapshot);
+
+
 	/// \section Util
 
+		/// get/set the particle id, set by the particle manager when added
+		inline unsigned int getId()     {return id;}
+		inline void setId(unsigned int i) {id = i;}
+
+		/// get/set the particle's slot in the manager's trails,
+		/// ofxParticleTrails::NO_SLOT if none
+		inline unsigned int getTrail()          {return trail;}
+		inline void setTrail(unsigned int slot) {trail = slot;}
+
+		/// get a random stream for this particle & the current frame, the
+		/// numbers only depend on the manager's seed, the id, & the frame so
+		/// they are the same no matter which thread updates the particle
+		ofxParticleRandom getRandom() {
+			return ofxParticleRandom(randomSeed, id, randomFrame);
+		}
+
+		/// set the seed & frame used by getRandom(), set by the particle
+		/// manager when added & before each update
+		inline void setRandomFrame(unsigned long long seed, unsigned int frame) {
+			randomSeed = seed;
+			randomFrame = frame;
+		}
+
 		/// get/set the particles lifespan in ms
 		inline unsigned int getLifespan()           {return lifespan;}
 		inline void setLifespan(unsigned int span)  {lifespan = span;}
@@ -91,6 +161,10 @@ class ofxParticle : public ofRectangle {
 
 		double lifespan;    ///< how long this particle should live in ms
 		double age;         ///< how old the particle is
+		unsigned int id;    ///< particle id, used for random streams
+		unsigned int trail; ///< trail slot
+		unsigned long long randomSeed; ///< manager random seed
+		unsigned int randomFrame;      ///< manager update frame
 
 		ofxTimer lifeTimer; ///< used to time the age between frames
 
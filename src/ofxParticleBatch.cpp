@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#include "ofxParticleBatch.h"
+
+#include "ofGraphics.h"
+#include "ofUtils.h"
+
+// quad corners as 2 triangles: x & y offset in the rect, same as tex coords
+static const float QUAD_CORNERS[6][2] = {
+	{0, 0}, {1, 0}, {1, 1},
+	{0, 0}, {1, 1}, {0, 1}
+};
+
+/// PARTICLE BATCH
+
+//--------------------------------------------------------------
+ofxParticleBatch::ofxParticleBatch() :
+	_numInstances(0), _currentBuffer(0), _texture(NULL), _bCentered(false),
+	_buildTime(0), _drawTime(0) {}
+
+//--------------------------------------------------------------
+void ofxParticleBatch::build(std::vector<ofxParticle*>& particles) {
+	unsigned long long start = ofGetElapsedTimeMicros();
+
+	// gather the live particles first so the parallel loop has no gaps
+	_visible.clear();
+	for(unsigned int i = 0; i < particles.size(); ++i) {
+		if(particles[i] != NULL && particles[i]->isAlive()) {
+			_visible.push_back(particles[i]);
+		}
+	}
+	_numInstances = _visible.size();
+
+	// only grows, the memory is kept between frames
+	if(_instances.size() < _numInstances) {
+		_instances.resize(_numInstances);
+		_vertices.resize(_numInstances * 6 * 2);
+		_colors.resize(_numInstances * 6 * 4);
+		_texCoords.resize(_numInstances * 6 * 2);
+	}
+
+	// each particle writes only its own slots
+	int num = _numInstances;
+	#ifdef _OPENMP
+		#pragma omp parallel for schedule(static)
+	#endif
+	for(int i = 0; i < num; ++i) {
+		_visible[i]->fillInstance(_instances[i]);
+		fillQuad(i);
+	}
+
+	_buildTime = ofGetElapsedTimeMicros() - start;
+}
+
+//--------------------------------------------------------------
+void ofxParticleBatch::draw() {
+	if(_numInstances == 0) {
+		_drawTime = 0;
+		return;
+	}
+	unsigned long long start = ofGetElapsedTimeMicros();
+
+	// reallocate only when the vbo is too small, otherwise update in place
+	Buffer& buffer = _buffers[_currentBuffer];
+	unsigned int numVertices = _numInstances * 6;
+	if(buffer.capacity < _numInstances) {
+		buffer.capacity = _instances.size();
+		unsigned int total = buffer.capacity * 6;
+		buffer.vbo.setVertexData(&_vertices[0], 2, total, GL_DYNAMIC_DRAW);
+		buffer.vbo.setColorData(&_colors[0], total, GL_DYNAMIC_DRAW);
+		buffer.vbo.setTexCoordData(&_texCoords[0], total, GL_DYNAMIC_DRAW);
+	}
+	else {
+		buffer.vbo.updateVertexData(&_vertices[0], numVertices);
+		buffer.vbo.updateColorData(&_colors[0], numVertices);
+		buffer.vbo.updateTexCoordData(&_texCoords[0], numVertices);
+	}
+
+	if(_texture != NULL) {
+		_texture->bind();
+	}
+	buffer.vbo.draw(GL_TRIANGLES, 0, numVertices);
+	if(_texture != NULL) {
+		_texture->unbind();
+	}
+
+	_currentBuffer = (_currentBuffer + 1) % 2;
+	_drawTime = ofGetElapsedTimeMicros() - start;
+}
+
+//--------------------------------------------------------------
+void ofxParticleBatch::clear() {
+	_visible.clear();
+	_numInstances = 0;
+}
+
+/* ***** PRIVATE ***** */
+
+//--------------------------------------------------------------
+void ofxParticleBatch::fillQuad(unsigned int i) {
+	const ofxParticleInstance& p = _instances[i];
+	float x = p.x, y = p.y;
+	if(_bCentered) {
+		x -= p.width * 0.5f;
+		y -= p.height * 0.5f;
+	}
+	float* v = &_vertices[i * 6 * 2];
+	float* c = &_colors[i * 6 * 4];
+	float* t = &_texCoords[i * 6 * 2];
+	for(int j = 0; j < 6; ++j) {
+		v[0] = x + QUAD_CORNERS[j][0] * p.width;
+		v[1] = y + QUAD_CORNERS[j][1] * p.height;
+		c[0] = p.r;
+		c[1] = p.g;
+		c[2] = p.b;
+		c[3] = p.a;
+		t[0] = QUAD_CORNERS[j][0];
+		t[1] = QUAD_CORNERS[j][1];
+		v += 2;
+		c += 4;
+		t += 2;
+	}
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#pragma once
+
+#include <vector>
+
+#include "ofVbo.h"
+#include "ofTexture.h"
+
+#include "ofxParticle.h"
+
+/**
+	\class  ParticleBatch
+	\brief  draws a list of particles as textured quads with a single draw call
+
+	build() asks each particle for its attributes via ofxParticle::fillInstance
+	& expands them into quad vertices on the CPU, the build is split across
+	threads when compiled with OpenMP (-fopenmp) & makes no GL calls, so it
+	can be timed without a window
+
+	draw() uploads the vertices into one of two persistent vbos, alternating
+	every frame so the upload doesn't wait on the GPU reading last frame's data
+
+	the quads have 0-1 tex coords, bind a sprite texture with setTexture() or
+	use your own shader with the instance attributes from getInstances()
+**/
+class ofxParticleBatch {
+	public:
+
+		ofxParticleBatch();
+
+	/// \section Build & Draw
+
+		/// fill the instance & vertex arrays from a list of particles,
+		/// NULL & dead particles are skipped
+		void build(std::vector<ofxParticle*>& particles);
+
+		/// upload & draw the last build
+		void draw();
+
+		/// discard the last build, keeps the allocated memory
+		void clear();
+
+	/// \section Settings
+
+		/// texture to bind when drawing, NULL for none (default),
+		/// load it after ofDisableArbTex() as the tex coords are 0-1
+		void setTexture(ofTexture* texture) {_texture = texture;}
+		ofTexture* getTexture()             {return _texture;}
+
+		/// draw the quads centered on the particle position instead of
+		/// from the upper left corner? (off by default)
+		void setCentered(bool centered) {_bCentered = centered;}
+		bool getCentered()              {return _bCentered;}
+
+	/// \section Util
+
+		/// the instance attributes from the last build
+		const std::vector<ofxParticleInstance>& getInstances() {return _instances;}
+
+		/// number of particles in the last build
+		unsigned int size() {return _numInstances;}
+
+		/// how long the last build took in us
+		unsigned long long getBuildTime() {return _buildTime;}
+
+		/// how long the last upload & draw took in us
+		unsigned long long getDrawTime()  {return _drawTime;}
+
+	private:
+
+		/// a vbo and how many particles it has room for
+		struct Buffer {
+			ofVbo vbo;
+			unsigned int capacity;
+			Buffer() : capacity(0) {}
+		};
+
+		/// write the 6 vertices of a particle quad at index i
+		void fillQuad(unsigned int i);
+
+		std::vector<ofxParticleInstance> _instances; ///< per particle attributes
+		std::vector<ofxParticle*> _visible;          ///< live particles to build
+
+		std::vector<float> _vertices;  ///< x, y per vertex
+		std::vector<float> _colors;    ///< r, g, b, a per vertex
+		std::vector<float> _texCoords; ///< u, v per vertex
+		unsigned int _numInstances;    ///< particles in the last build
+
+		Buffer _buffers[2];  ///< double buffered vbos
+		int _currentBuffer;  ///< which vbo to upload to next
+
+		ofTexture* _texture; ///< sprite texture, may be NULL
+		bool _bCentered;     ///< draw centered quads?
+
+		unsigned long long _buildTime, _drawTime; ///< last timings in us
+};
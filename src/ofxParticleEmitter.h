@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#pragma once
+
+#include <cmath>
+
+#include "ofxParticle.h"
+
+/**
+	\class  ParticleEmitter
+	\brief  base class that spawns particles at a rate or in bursts
+
+	implement spawn() to create a new particle & add the emitter to an
+	ofxParticleManager, which calls it as needed each update
+
+	the rate is amortized with an accumulator so fractional amounts carry over
+	between frames, ie 30 particles/sec at 60 fps spawns one every other frame
+
+	use the random stream in spawn() instead of ofRandom(), the manager keys
+	it by its seed & the frame so runs with the same seed spawn the same
+	particles
+**/
+class ofxParticleEmitter {
+	public:
+
+		ofxParticleEmitter(float rate=0) :
+			bEnabled(true), rate(rate), accumulator(0), burstCount(0) {}
+		virtual ~ofxParticleEmitter() {}
+
+		/// create a new particle, return NULL to skip
+		virtual ofxParticle* spawn() = 0;
+
+	/// \section Spawning
+
+		/// spawn a number of particles at the next update
+		void burst(unsigned int count) {burstCount += count;}
+
+		/// get the number of particles to spawn for a time step in seconds,
+		/// scale scales the rate & is used by the manager's budget,
+		/// includes & clears any pending bursts
+		unsigned int emit(float seconds, float scale=1) {
+			if(!bEnabled) {
+				return 0;
+			}
+			accumulator += rate * scale * seconds;
+			unsigned int count = (unsigned int) floorf(accumulator);
+			accumulator -= count;
+			count += burstCount;
+			burstCount = 0;
+			return count;
+		}
+
+		/// discard the accumulated time & pending bursts
+		void reset() {accumulator = 0; burstCount = 0;}
+
+	/// \section Snapshot
+
+		/// write the emitter state to a snapshot, override to add your own
+		/// state after calling this
+		virtual void save(ofxParticleSnapshot& snapshot) {
+			snapshot.write(bEnabled);
+			snapshot.write(rate);
+			snapshot.write(accumulator);
+			snapshot.write(burstCount);
+		}
+
+		/// read the emitter state in the same order as save(), returns false
+		/// if the snapshot ran out of data
+		virtual bool load(ofxParticleSnapshot& snapshot) {
+			snapshot.read(bEnabled);
+			snapshot.read(rate);
+			snapshot.read(accumulator);
+			snapshot.read(burstCount);
+			return snapshot.isGood();
+		}
+
+	/// \section Util
+
+		/// get/set the spawn rate in particles per second
+		inline float getRate()    {return rate;}
+		void setRate(float perSec) {rate = perSec < 0 ? 0 : perSec;}
+
+		/// the random stream for spawn(), set by the manager before spawning
+		ofxParticleRandom& getRandom() {return random;}
+
+		/// enable/disable spawning, disabled emitters also ignore bursts
+		inline bool isEnabled()         {return bEnabled;}
+		void setEnabled(bool enabled) {bEnabled = enabled;}
+
+	protected:
+
+		bool bEnabled;           ///< spawn particles?
+		float rate;              ///< particles per second
+		float accumulator;       ///< fractional particles carried between frames
+		unsigned int burstCount; ///< pending burst particles
+		ofxParticleRandom random; ///< spawn random stream
+};
@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#include "ofxParticleForces.h"
+
+#include <cmath>
+#include <algorithm>
+
+#include "ofxParticleMotion.h"
+#include "ofMath.h"
+
+#ifdef __SSE__
+	#include <xmmintrin.h>
+#endif
+
+// smallest squared distance, avoids dividing by 0 at a force center
+#define FORCE_EPSILON 0.0001f
+
+/// UNIFORM FORCE
+
+//--------------------------------------------------------------
+void ofxParticleUniformForce::apply(ofxParticleMotion& motion, unsigned int begin, unsigned int end) {
+	float* ax = &motion.ax[0];
+	float* ay = &motion.ay[0];
+	unsigned int i = begin;
+	#ifdef __SSE__
+		__m128 fx = _mm_set1_ps(x), fy = _mm_set1_ps(y);
+		for(; i+4 <= end; i += 4) {
+			_mm_storeu_ps(ax+i, _mm_add_ps(_mm_loadu_ps(ax+i), fx));
+			_mm_storeu_ps(ay+i, _mm_add_ps(_mm_loadu_ps(ay+i), fy));
+		}
+	#endif
+	for(; i < end; ++i) {
+		ax[i] += x;
+		ay[i] += y;
+	}
+}
+
+/// ATTRACTOR
+
+//--------------------------------------------------------------
+void ofxParticleAttractor::apply(ofxParticleMotion& motion, unsigned int begin, unsigned int end) {
+	if(radius <= 0)
+		return;
+	const float* px = &motion.x[0];
+	const float* py = &motion.y[0];
+	float* ax = &motion.ax[0];
+	float* ay = &motion.ay[0];
+	float radius2 = radius * radius, invRadius = 1 / radius;
+	unsigned int i = begin;
+	#ifdef __SSE__
+		__m128 cx = _mm_set1_ps(x), cy = _mm_set1_ps(y);
+		__m128 s = _mm_set1_ps(strength), r2 = _mm_set1_ps(radius2);
+		__m128 ir = _mm_set1_ps(invRadius), one = _mm_set1_ps(1);
+		__m128 eps = _mm_set1_ps(FORCE_EPSILON);
+		for(; i+4 <= end; i += 4) {
+			__m128 dx = _mm_sub_ps(cx, _mm_loadu_ps(px+i));
+			__m128 dy = _mm_sub_ps(cy, _mm_loadu_ps(py+i));
+			__m128 d2 = _mm_max_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), eps);
+			__m128 d = _mm_sqrt_ps(d2);
+			// strength * (1 - d/radius) / d, 0 outside the radius
+			__m128 f = _mm_div_ps(_mm_mul_ps(s, _mm_sub_ps(one, _mm_mul_ps(d, ir))), d);
+			f = _mm_and_ps(f, _mm_cmplt_ps(d2, r2));
+			_mm_storeu_ps(ax+i, _mm_add_ps(_mm_loadu_ps(ax+i), _mm_mul_ps(dx, f)));
+			_mm_storeu_ps(ay+i, _mm_add_ps(_mm_loadu_ps(ay+i), _mm_mul_ps(dy, f)));
+		}
+	#endif
+	for(; i < end; ++i) {
+		float dx = x - px[i], dy = y - py[i];
+		float d2 = dx*dx + dy*dy;
+		if(d2 >= radius2)
+			continue;
+		float d = sqrtf(d2 < FORCE_EPSILON ? FORCE_EPSILON : d2);
+		float f = strength * (1 - d * invRadius) / d;
+		ax[i] += dx * f;
+		ay[i] += dy * f;
+	}
+}
+
+/// VORTEX
+
+//--------------------------------------------------------------
+void ofxParticleVortex::apply(ofxParticleMotion& motion, unsigned int begin, unsigned int end) {
+	if(radius <= 0)
+		return;
+	const float* px = &motion.x[0];
+	const float* py = &motion.y[0];
+	float* ax = &motion.ax[0];
+	float* ay = &motion.ay[0];
+	float radius2 = radius * radius, invRadius = 1 / radius;
+	unsigned int i = begin;
+	#ifdef __SSE__
+		__m128 cx = _mm_set1_ps(x), cy = _mm_set1_ps(y);
+		__m128 s = _mm_set1_ps(strength), r2 = _mm_set1_ps(radius2);
+		__m128 ir = _mm_set1_ps(invRadius), one = _mm_set1_ps(1);
+		__m128 eps = _mm_set1_ps(FORCE_EPSILON);
+		for(; i+4 <= end; i += 4) {
+			__m128 dx = _mm_sub_ps(_mm_loadu_ps(px+i), cx);
+			__m128 dy = _mm_sub_ps(_mm_loadu_ps(py+i), cy);
+			__m128 d2 = _mm_max_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), eps);
+			__m128 d = _mm_sqrt_ps(d2);
+			__m128 f = _mm_div_ps(_mm_mul_ps(s, _mm_sub_ps(one, _mm_mul_ps(d, ir))), d);
+			f = _mm_and_ps(f, _mm_cmplt_ps(d2, r2));
+			// tangent is the offset rotated 90 degrees: (-dy, dx)
+			_mm_storeu_ps(ax+i, _mm_sub_ps(_mm_loadu_ps(ax+i), _mm_mul_ps(dy, f)));
+			_mm_storeu_ps(ay+i, _mm_add_ps(_mm_loadu_ps(ay+i), _mm_mul_ps(dx, f)));
+		}
+	#endif
+	for(; i < end; ++i) {
+		float dx = px[i] - x, dy = py[i] - y;
+		float d2 = dx*dx + dy*dy;
+		if(d2 >= radius2)
+			continue;
+		float d = sqrtf(d2 < FORCE_EPSILON ? FORCE_EPSILON : d2);
+		float f = strength * (1 - d * invRadius) / d;
+		ax[i] -= dy * f;
+		ay[i] += dx * f;
+	}
+}
+
+/// DRAG
+
+//--------------------------------------------------------------
+void ofxParticleDrag::apply(ofxParticleMotion& motion, unsigned int begin, unsigned int end) {
+	const float* vx = &motion.vx[0];
+	const float* vy = &motion.vy[0];
+	float* ax = &motion.ax[0];
+	float* ay = &motion.ay[0];
+	unsigned int i = begin;
+	#ifdef __SSE__
+		__m128 k = _mm_set1_ps(amount);
+		for(; i+4 <= end; i += 4) {
+			_mm_storeu_ps(ax+i, _mm_sub_ps(_mm_loadu_ps(ax+i), _mm_mul_ps(_mm_loadu_ps(vx+i), k)));
+			_mm_storeu_ps(ay+i, _mm_sub_ps(_mm_loadu_ps(ay+i), _mm_mul_ps(_mm_loadu_ps(vy+i), k)));
+		}
+	#endif
+	for(; i < end; ++i) {
+		ax[i] -= vx[i] * amount;
+		ay[i] -= vy[i] * amount;
+	}
+}
+
+/// FLOW FIELD
+
+//--------------------------------------------------------------
+ofxParticleFlowField::ofxParticleFlowField(float x, float y, float w, float h,
+                                           unsigned int cols, unsigned int rows) :
+	evolve(0), strength(100), _scale(0.005), _time(0), _bDirty(true) {
+	setRegion(x, y, w, h);
+	setResolution(cols, rows);
+}
+
+//--------------------------------------------------------------
+void ofxParticleFlowField::prepare(float dt) {
+	if(evolve != 0) {
+		_time += evolve * dt;
+		_bDirty = true;
+	}
+	if(_bDirty) {
+		_rebuild();
+	}
+}
+
+//--------------------------------------------------------------
+void ofxParticleFlowField::apply(ofxParticleMotion& motion, unsigned int begin, unsigned int end) {
+	const float* px = &motion.x[0];
+	const float* py = &motion.y[0];
+	float* ax = &motion.ax[0];
+	float* ay = &motion.ay[0];
+	float fx, fy;
+	for(unsigned int i = begin; i < end; ++i) { // grid lookups don't vectorize
+		sample(px[i], py[i], fx, fy);
+		ax[i] += fx * strength;
+		ay[i] += fy * strength;
+	}
+}
+
+//--------------------------------------------------------------
+void ofxParticleFlowField::sample(float px, float py, float& fx, float& fy) {
+	if(_fx.empty()) {
+		fx = fy = 0;
+		return;
+	}
+
+	// grid nodes are at the cell corners
+	float gx = ofClamp((px - _x) / _w * (_cols-1), 0, _cols-1);
+	float gy = ofClamp((py - _y) / _h * (_rows-1), 0, _rows-1);
+	unsigned int c = std::min((unsigned int) gx, _cols-2);
+	unsigned int r = std::min((unsigned int) gy, _rows-2);
+	float tx = gx - c, ty = gy - r;
+
+	unsigned int i = r * _cols + c;
+	float top = _fx[i] + (_fx[i+1] - _fx[i]) * tx;
+	float bottom = _fx[i+_cols] + (_fx[i+_cols+1] - _fx[i+_cols]) * tx;
+	fx = top + (bottom - top) * ty;
+	top = _fy[i] + (_fy[i+1] - _fy[i]) * tx;
+	bottom = _fy[i+_cols] + (_fy[i+_cols+1] - _fy[i+_cols]) * tx;
+	fy = top + (bottom - top) * ty;
+}
+
+//--------------------------------------------------------------
+void ofxParticleFlowField::setRegion(float x, float y, float w, float h) {
+	_x = x;
+	_y = y;
+	_w = w > 0 ? w : 1;
+	_h = h > 0 ? h : 1;
+	_bDirty = true;
+}
+
+//--------------------------------------------------------------
+void ofxParticleFlowField::setResolution(unsigned int cols, unsigned int rows) {
+	_cols = cols < 2 ? 2 : cols;
+	_rows = rows < 2 ? 2 : rows;
+	_bDirty = true;
+}
+
+/* ***** PRIVATE ***** */
+
+//--------------------------------------------------------------
+void ofxParticleFlowField::_rebuild() {
+	_fx.resize(_cols * _rows);
+	_fy.resize(_cols * _rows);
+
+	// curl of the noise potential, (dn/dy, -dn/dx), by central differences
+	// in noise space, the flow speed is around 1
+	const float step = 0.01f;
+	float cellW = _w / (_cols-1), cellH = _h / (_rows-1);
+	for(unsigned int r = 0; r < _rows; ++r) {
+		for(unsigned int c = 0; c < _cols; ++c) {
+			float nx = (_x + c * cellW) * _scale, ny = (_y + r * cellH) * _scale;
+			float dndx = ofSignedNoise(nx + step, ny, _time) - ofSignedNoise(nx - step, ny, _time);
+			float dndy = ofSignedNoise(nx, ny + step, _time) - ofSignedNoise(nx, ny - step, _time);
+			_fx[r * _cols + c] = dndy / (2 * step);
+			_fy[r * _cols + c] = -dndx / (2 * step);
+		}
+	}
+	_bDirty = false;
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#pragma once
+
+#include <vector>
+
+class ofxParticleMotion;
+
+/**
+	\class  ParticleForce
+	\brief  a force field operator applied to an ofxParticleMotion
+
+	forces add accelerations (units per second²) to the motion's ax & ay
+	arrays for a range of particles, the range is a chunk which may be
+	processed on a separate thread, so only write to the given range &
+	don't change the force's own state in apply()
+**/
+class ofxParticleForce {
+	public:
+
+		ofxParticleForce() : bEnabled(true) {}
+		virtual ~ofxParticleForce() {}
+
+		/// called once per motion update before apply(), on the calling thread
+		virtual void prepare(float dt) {}
+
+		/// add accelerations for the particles from begin up to end
+		virtual void apply(ofxParticleMotion& motion, unsigned int begin, unsigned int end) = 0;
+
+		/// disabled forces are skipped
+		inline bool isEnabled()       {return bEnabled;}
+		void setEnabled(bool enabled) {bEnabled = enabled;}
+
+	protected:
+
+		bool bEnabled; ///< apply this force?
+};
+
+/// a constant acceleration, ie gravity or wind
+class ofxParticleUniformForce : public ofxParticleForce {
+	public:
+
+		ofxParticleUniformForce(float x=0, float y=0) : x(x), y(y) {}
+
+		void apply(ofxParticleMotion& motion, unsigned int begin, unsigned int end);
+
+		float x, y; ///< acceleration
+};
+
+/// pulls particles toward a point (positive strength) or pushes them away
+/// (negative strength) with a linear falloff to 0 at the radius
+class ofxParticleAttractor : public ofxParticleForce {
+	public:
+
+		ofxParticleAttractor(float x=0, float y=0, float strength=100, float radius=100) :
+			x(x), y(y), strength(strength), radius(radius) {}
+
+		void apply(ofxParticleMotion& motion, unsigned int begin, unsigned int end);
+
+		float x, y;     ///< center
+		float strength; ///< acceleration at the center, < 0 repels
+		float radius;   ///< no effect outside this distance
+};
+
+/// spins particles around a point, counter clockwise for positive strength,
+/// with a linear falloff to 0 at the radius
+class ofxParticleVortex : public ofxParticleForce {
+	public:
+
+		ofxParticleVortex(float x=0, float y=0, float strength=100, float radius=100) :
+			x(x), y(y), strength(strength), radius(radius) {}
+
+		void apply(ofxParticleMotion& motion, unsigned int begin, unsigned int end);
+
+		float x, y;     ///< center
+		float strength; ///< tangential acceleration at the center
+		float radius;   ///< no effect outside this distance
+};
+
+/// slows particles down in proportion to their velocity
+class ofxParticleDrag : public ofxParticleForce {
+	public:
+
+		ofxParticleDrag(float amount=1) : amount(amount) {}
+
+		void apply(ofxParticleMotion& motion, unsigned int begin, unsigned int end);
+
+		float amount; ///< drag coefficient per second
+};
+
+/**
+	\class  ParticleFlowField
+	\brief  pushes particles along a divergence free curl noise flow
+
+	the flow is the curl of a noise field sampled into a cached grid covering
+	a region, particles are pushed with the bilinearly interpolated grid
+	velocity & particles outside the region use the nearest edge cell
+
+	the grid is only rebuilt when the settings change or, if the evolve speed
+	is > 0, once per update as the noise moves through time
+**/
+class ofxParticleFlowField : public ofxParticleForce {
+	public:
+
+		/// region in world units & grid resolution in cells
+		ofxParticleFlowField(float x=0, float y=0, float w=1024, float h=768,
+		                     unsigned int cols=64, unsigned int rows=48);
+
+		void prepare(float dt);
+		void apply(ofxParticleMotion& motion, unsigned int begin, unsigned int end);
+
+		/// sample the flow at a position
+		void sample(float px, float py, float& fx, float& fy);
+
+	/// \section Settings
+
+		/// region & grid resolution
+		void setRegion(float x, float y, float w, float h);
+		void setResolution(unsigned int cols, unsigned int rows);
+
+		/// noise frequency, higher is more turbulent (default 0.005)
+		void setScale(float scale) {_scale = scale; _bDirty = true;}
+		float getScale()           {return _scale;}
+
+		/// noise time units per second, 0 for a static field (default 0)
+		float evolve;
+
+		/// acceleration for a unit flow velocity (default 100)
+		float strength;
+
+	private:
+
+		/// fill the grid from the noise field
+		void _rebuild();
+
+		float _x, _y, _w, _h;          ///< region
+		unsigned int _cols, _rows;     ///< grid resolution
+		float _scale;                  ///< noise frequency
+		float _time;                   ///< noise time
+		bool _bDirty;                  ///< rebuild on the next prepare?
+		std::vector<float> _fx, _fy;   ///< flow per grid node
+};
@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#include "ofxParticleGrid.h"
+
+#include <algorithm>
+#include <climits>
+
+#include "ofLog.h"
+
+/// PARTICLE GRID
+
+//--------------------------------------------------------------
+ofxParticleGrid::ofxParticleGrid(float cellSize, unsigned int numBuckets) :
+	_cellSize(1), _invCellSize(1), _numItems(0),
+	_minX(INT_MAX), _minY(INT_MAX), _maxX(INT_MIN), _maxY(INT_MIN), _bBoundsStale(false),
+	_stamp(0) {
+	_buckets.resize(numBuckets > 0 ? numBuckets : 1);
+	setCellSize(cellSize);
+}
+
+//--------------------------------------------------------------
+void ofxParticleGrid::update(unsigned int index, const ofRectangle& rect) {
+	if(index >= _items.size()) {
+		_items.resize(index+1);
+		_stamps.resize(index+1, 0);
+	}
+	Item& item = _items[index];
+	item.rect = rect;
+	int x1 = cell(rect.x), y1 = cell(rect.y);
+	int x2 = cell(rect.x + rect.width), y2 = cell(rect.y + rect.height);
+	if(item.bUsed) {
+		if(x1 == item.x1 && y1 == item.y1 && x2 == item.x2 && y2 == item.y2) {
+			return; // same cells, nothing to move
+		}
+		unlink(index);
+	}
+	else {
+		item.bUsed = true;
+		_numItems++;
+	}
+	item.x1 = x1;
+	item.y1 = y1;
+	item.x2 = x2;
+	item.y2 = y2;
+	link(index);
+}
+
+//--------------------------------------------------------------
+void ofxParticleGrid::remove(unsigned int index) {
+	if(!contains(index))
+		return;
+	unlink(index);
+	_items[index].bUsed = false;
+	_numItems--;
+}
+
+//--------------------------------------------------------------
+void ofxParticleGrid::resize(unsigned int size) {
+	for(unsigned int i = size; i < _items.size(); ++i) {
+		remove(i);
+	}
+	if(size < _items.size()) {
+		_items.resize(size);
+		_stamps.resize(size);
+	}
+}
+
+//--------------------------------------------------------------
+void ofxParticleGrid::clear() {
+	for(unsigned int i = 0; i < _buckets.size(); ++i) {
+		_buckets[i].clear();
+	}
+	_items.clear();
+	_stamps.clear();
+	_numItems = 0;
+	_minX = _minY = INT_MAX;
+	_maxX = _maxY = INT_MIN;
+	_bBoundsStale = false;
+}
+
+//--------------------------------------------------------------
+void ofxParticleGrid::queryRange(const ofRectangle& area, std::vector<unsigned int>& results) {
+	results.clear();
+	gather(area.x, area.y, area.x + area.width, area.y + area.height, _candidates);
+	for(unsigned int i = 0; i < _candidates.size(); ++i) {
+		const ofRectangle& r = _items[_candidates[i]].rect;
+		if(r.x <= area.x + area.width && r.x + r.width >= area.x &&
+		   r.y <= area.y + area.height && r.y + r.height >= area.y) {
+			results.push_back(_candidates[i]);
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void ofxParticleGrid::queryPoint(float x, float y, std::vector<unsigned int>& results) {
+	queryRange(ofRectangle(x, y, 0, 0), results);
+}
+
+//--------------------------------------------------------------
+void ofxParticleGrid::queryRadius(const ofVec2f& center, float radius, std::vector<unsigned int>& results) {
+	results.clear();
+	gather(center.x - radius, center.y - radius, center.x + radius, center.y + radius, _candidates);
+	float radiusSquared = radius * radius;
+	for(unsigned int i = 0; i < _candidates.size(); ++i) {
+		if(distanceSquared(_items[_candidates[i]].rect, center.x, center.y) <= radiusSquared) {
+			results.push_back(_candidates[i]);
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void ofxParticleGrid::queryNearest(const ofVec2f& point, unsigned int k, std::vector<unsigned int>& results) {
+	results.clear();
+	if(k == 0 || _numItems == 0)
+		return;
+
+	// grow the search square until it holds k items within its radius
+	// or holds every item, the k nearest must then be in it
+	std::vector< std::pair<float, unsigned int> > found;
+	float radius = _cellSize;
+	while(true) {
+		gather(point.x - radius, point.y - radius, point.x + radius, point.y + radius, _candidates);
+		bool all = _candidates.size() >= _numItems ||
+		           (cell(point.x - radius) <= _minX && cell(point.x + radius) >= _maxX &&
+		            cell(point.y - radius) <= _minY && cell(point.y + radius) >= _maxY);
+		found.clear();
+		for(unsigned int i = 0; i < _candidates.size(); ++i) {
+			const ofRectangle& r = _items[_candidates[i]].rect;
+			float dx = r.x + r.width * 0.5f - point.x;
+			float dy = r.y + r.height * 0.5f - point.y;
+			float d = dx * dx + dy * dy;
+			if(all || d <= radius * radius) {
+				found.push_back(std::make_pair(d, _candidates[i]));
+			}
+		}
+		if(all || found.size() >= k)
+			break;
+		radius *= 2;
+	}
+
+	if(k > found.size()) {
+		k = found.size();
+	}
+	std::partial_sort(found.begin(), found.begin() + k, found.end());
+	for(unsigned int i = 0; i < k; ++i) {
+		results.push_back(found[i].second);
+	}
+}
+
+//--------------------------------------------------------------
+void ofxParticleGrid::queryPairs(std::vector<Pair>& pairs) {
+	pairs.clear();
+	std::vector<unsigned int> overlaps;
+	for(unsigned int i = 0; i < _items.size(); ++i) {
+		if(!_items[i].bUsed)
+			continue;
+		queryRange(_items[i].rect, overlaps);
+		for(unsigned int j = 0; j < overlaps.size(); ++j) {
+			if(overlaps[j] > i) { // report each pair once
+				pairs.push_back(std::make_pair(i, overlaps[j]));
+			}
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void ofxParticleGrid::setCellSize(float size) {
+	if(size <= 0) {
+		ofLogWarning("ofxParticleGrid") << "cell size must be > 0";
+		return;
+	}
+	_cellSize = size;
+	_invCellSize = 1.0f / size;
+
+	// relink everything with the new cell ranges
+	std::vector<Item> items = _items;
+	clear();
+	for(unsigned int i = 0; i < items.size(); ++i) {
+		if(items[i].bUsed) {
+			update(i, items[i].rect);
+		}
+	}
+}
+
+/* ***** PRIVATE ***** */
+
+//--------------------------------------------------------------
+void ofxParticleGrid::link(unsigned int index) {
+	const Item& item = _items[index];
+	for(int y = item.y1; y <= item.y2; ++y) {
+		for(int x = item.x1; x <= item.x2; ++x) {
+			_buckets[bucket(x, y)].push_back(index);
+		}
+	}
+	_minX = std::min(_minX, item.x1);
+	_minY = std::min(_minY, item.y1);
+	_maxX = std::max(_maxX, item.x2);
+	_maxY = std::max(_maxY, item.y2);
+}
+
+void ofxParticleGrid::unlink(unsigned int index) {
+	const Item& item = _items[index];
+	if(item.x1 == _minX || item.y1 == _minY || item.x2 == _maxX || item.y2 == _maxY) {
+		_bBoundsStale = true; // may have been the only item on the edge
+	}
+	for(int y = item.y1; y <= item.y2; ++y) {
+		for(int x = item.x1; x <= item.x2; ++x) {
+			// order doesn't matter, so swap with the last & pop
+			std::vector<unsigned int>& b = _buckets[bucket(x, y)];
+			std::vector<unsigned int>::iterator iter = std::find(b.begin(), b.end(), index);
+			if(iter != b.end()) {
+				*iter = b.back();
+				b.pop_back();
+			}
+		}
+	}
+}
+
+void ofxParticleGrid::updateBounds() {
+	if(!_bBoundsStale)
+		return;
+	_minX = _minY = INT_MAX;
+	_maxX = _maxY = INT_MIN;
+	for(unsigned int i = 0; i < _items.size(); ++i) {
+		const Item& item = _items[i];
+		if(item.bUsed) {
+			_minX = std::min(_minX, item.x1);
+			_minY = std::min(_minY, item.y1);
+			_maxX = std::max(_maxX, item.x2);
+			_maxY = std::max(_maxY, item.y2);
+		}
+	}
+	_bBoundsStale = false;
+}
+
+//--------------------------------------------------------------
+void ofxParticleGrid::gather(float x1, float y1, float x2, float y2, std::vector<unsigned int>& candidates) {
+	candidates.clear();
+	if(_numItems == 0)
+		return;
+	updateBounds();
+
+	// new stamp, reset all when it wraps
+	if(++_stamp == 0) {
+		std::fill(_stamps.begin(), _stamps.end(), 0);
+		_stamp = 1;
+	}
+
+	// no need to look outside the cells in use
+	int cx1 = std::max(cell(x1), _minX), cy1 = std::max(cell(y1), _minY);
+	int cx2 = std::min(cell(x2), _maxX), cy2 = std::min(cell(y2), _maxY);
+	for(int y = cy1; y <= cy2; ++y) {
+		for(int x = cx1; x <= cx2; ++x) {
+			const std::vector<unsigned int>& b = _buckets[bucket(x, y)];
+			for(unsigned int i = 0; i < b.size(); ++i) {
+				if(_stamps[b[i]] != _stamp) {
+					_stamps[b[i]] = _stamp;
+					candidates.push_back(b[i]);
+				}
+			}
+		}
+	}
+}
+
+//--------------------------------------------------------------
+float ofxParticleGrid::distanceSquared(const ofRectangle& rect, float x, float y) {
+	float dx = 0, dy = 0;
+	if(x < rect.x) dx = rect.x - x;
+	else if(x > rect.x + rect.width) dx = x - (rect.x + rect.width);
+	if(y < rect.y) dy = rect.y - y;
+	else if(y > rect.y + rect.height) dy = y - (rect.y + rect.height);
+	return dx * dx + dy * dy;
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#pragma once
+
+#include <vector>
+#include <utility>
+
+#include "ofRectangle.h"
+#include "ofVectorMath.h"
+
+/**
+	\class  ParticleGrid
+	\brief  a uniform grid spatial index over rectangles
+
+	items are identified by an index, usually the particle's position in the
+	particle list or in a contiguous particle array, so the same grid works
+	for both ways of storing particles
+
+	cells are hashed into a fixed number of buckets so the grid has no bounds,
+	an item is added to every cell its rect overlaps & is only moved when the
+	range of cells changes, which makes per frame updates cheap for slow
+	moving particles
+
+	choose a cell size around the size of the typical particle or query area
+**/
+class ofxParticleGrid {
+	public:
+
+		/// a pair of overlapping item indices, first < second
+		typedef std::pair<unsigned int, unsigned int> Pair;
+
+		ofxParticleGrid(float cellSize=32, unsigned int numBuckets=1024);
+
+	/// \section Items
+
+		/// add or move an item, only touches the buckets if the item's
+		/// cell range changed
+		void update(unsigned int index, const ofRectangle& rect);
+
+		/// remove an item
+		void remove(unsigned int index);
+
+		/// remove all items with an index >= size, use this after updating
+		/// the items of a list that shrank
+		void resize(unsigned int size);
+
+		/// remove all items
+		void clear();
+
+		/// is there an item at this index?
+		bool contains(unsigned int index) {
+			return index < _items.size() && _items[index].bUsed;
+		}
+
+		/// number of items
+		unsigned int size() {return _numItems;}
+
+	/// \section Queries
+	///
+	/// the results vectors are cleared first & items are only reported once
+
+		/// items whose rect overlaps an area
+		void queryRange(const ofRectangle& area, std::vector<unsigned int>& results);
+
+		/// items whose rect contains a point
+		void queryPoint(float x, float y, std::vector<unsigned int>& results);
+
+		/// items whose rect is within a radius of a point
+		void queryRadius(const ofVec2f& center, float radius, std::vector<unsigned int>& results);
+
+		/// the k items whose rect centers are closest to a point,
+		/// sorted nearest first
+		void queryNearest(const ofVec2f& point, unsigned int k, std::vector<unsigned int>& results);
+
+		/// all pairs of items with overlapping rects
+		void queryPairs(std::vector<Pair>& pairs);
+
+	/// \section Settings
+
+		/// the cell size, changing it rebuilds the grid
+		void setCellSize(float size);
+		float getCellSize() {return _cellSize;}
+
+	private:
+
+		/// an indexed item & the cells it covers
+		struct Item {
+			ofRectangle rect;
+			int x1, y1, x2, y2; ///< cell range, inclusive
+			bool bUsed;
+			Item() : x1(0), y1(0), x2(-1), y2(-1), bUsed(false) {}
+		};
+
+		/// add/remove an item to/from the buckets of its cell range
+		void link(unsigned int index);
+		void unlink(unsigned int index);
+
+		/// recompute the bounds from the linked items if an item on the
+		/// edge was unlinked
+		void updateBounds();
+
+		/// gather candidates from the cells overlapping an area, uses the
+		/// query stamp so each item is only visited once
+		void gather(float x1, float y1, float x2, float y2, std::vector<unsigned int>& candidates);
+
+		/// cell coordinate of a position
+		inline int cell(float v) {return (int) floorf(v * _invCellSize);}
+
+		/// bucket for a cell
+		inline unsigned int bucket(int x, int y) {
+			return ((unsigned int) x * 73856093u ^ (unsigned int) y * 19349663u) % _buckets.size();
+		}
+
+		/// squared distance between a point & a rect, 0 if inside
+		static float distanceSquared(const ofRectangle& rect, float x, float y);
+
+		float _cellSize, _invCellSize; ///< cell size & 1/size
+
+		std::vector<Item> _items; ///< items by index
+		std::vector< std::vector<unsigned int> > _buckets; ///< hashed cells
+		unsigned int _numItems;   ///< number of used items
+
+		int _minX, _minY, _maxX, _maxY; ///< bounds of all linked cells
+		bool _bBoundsStale; ///< was an item on the bounds unlinked?
+
+		std::vector<unsigned int> _stamps; ///< last query that visited an item
+		unsigned int _stamp;               ///< current query stamp
+		std::vector<unsigned int> _candidates; ///< query scratch space
+};
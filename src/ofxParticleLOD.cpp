@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#include "ofxParticleLOD.h"
+
+#include "ofUtils.h"
+#include "ofAppRunner.h"
+#include "ofMath.h"
+
+// weight of the newest measurement in the smoothed times
+static const float SMOOTHING = 0.2f;
+
+// allow for frame timing jitter when comparing against the target
+static const float FRAME_TOLERANCE = 1.1f;
+
+/// PARTICLE LOD
+
+//--------------------------------------------------------------
+ofxParticleLOD::ofxParticleLOD() :
+	_targetFrameTime(1000.0f/60.0f), _updateBudget(4), _drawBudget(4),
+	_framesUp(10), _framesDown(60), _recoverRatio(0.75f),
+	_minSize(2), _minAlpha(0.05f), _oldAge(0.75f), _focusDistance(0),
+	_level(0), _maxLevel(MAX_LEVEL) {
+	reset();
+}
+
+//--------------------------------------------------------------
+void ofxParticleLOD::setHysteresis(unsigned int framesUp, unsigned int framesDown) {
+	_framesUp = framesUp > 0 ? framesUp : 1;
+	_framesDown = framesDown > 0 ? framesDown : 1;
+}
+
+//--------------------------------------------------------------
+void ofxParticleLOD::beginUpdate() {
+	_updateStart = ofGetElapsedTimeMicros();
+}
+
+void ofxParticleLOD::endUpdate() {
+	float ms = (ofGetElapsedTimeMicros() - _updateStart) / 1000.0f;
+	_updateTime = _bMeasured ? _updateTime + (ms - _updateTime) * SMOOTHING : ms;
+	_bMeasured = true;
+}
+
+void ofxParticleLOD::beginDraw() {
+	_drawStart = ofGetElapsedTimeMicros();
+}
+
+void ofxParticleLOD::endDraw() {
+	float ms = (ofGetElapsedTimeMicros() - _drawStart) / 1000.0f;
+	_drawTime = _drawTime + (ms - _drawTime) * SMOOTHING;
+}
+
+//--------------------------------------------------------------
+void ofxParticleLOD::evaluate() {
+	evaluate(ofGetLastFrameTime() * 1000.0f);
+}
+
+void ofxParticleLOD::evaluate(float frameTime) {
+	_frame++;
+	if(!_bMeasured)
+		return;
+
+	_frameTime = _frameTime + (frameTime - _frameTime) * SMOOTHING;
+
+	// what's over budget & is there headroom everywhere?
+	_overReasons = NONE;
+	bool headroom = true;
+	if(_updateBudget > 0) {
+		if(_updateTime > _updateBudget) _overReasons |= UPDATE_TIME;
+		if(_updateTime > _updateBudget * _recoverRatio) headroom = false;
+	}
+	if(_drawBudget > 0) {
+		if(_drawTime > _drawBudget) _overReasons |= DRAW_TIME;
+		if(_drawTime > _drawBudget * _recoverRatio) headroom = false;
+	}
+	if(_targetFrameTime > 0) {
+		// a vsynced or capped app never runs faster than the target, so the
+		// frame time only needs to be back on target to recover
+		if(_frameTime > _targetFrameTime * FRAME_TOLERANCE) {
+			_overReasons |= FRAME_TIME;
+			headroom = false;
+		}
+	}
+
+	if(_overReasons != NONE) {
+		_underFrames = 0;
+		if(++_overFrames >= _framesUp) {
+			_overFrames = 0;
+			if(_level < _maxLevel) {
+				_level++;
+				_reasons |= _overReasons;
+			}
+		}
+	}
+	else if(headroom) {
+		_overFrames = 0;
+		if(++_underFrames >= _framesDown) {
+			_underFrames = 0;
+			if(_level > 0) {
+				_level--;
+				if(_level == 0) {
+					_reasons = NONE;
+				}
+			}
+		}
+	}
+	else { // in between, hold the current level
+		_overFrames = 0;
+		_underFrames = 0;
+	}
+}
+
+//--------------------------------------------------------------
+void ofxParticleLOD::reset() {
+	_level = 0;
+	_reasons = NONE;
+	_overReasons = NONE;
+	_overFrames = _underFrames = 0;
+	_frame = 0;
+	_updateStart = _drawStart = 0;
+	_updateTime = _drawTime = _frameTime = 0;
+	_bMeasured = false;
+}
+
+//--------------------------------------------------------------
+bool ofxParticleLOD::shouldDraw(ofxParticle& particle) {
+	if(_level < 1)
+		return true;
+	if(particle.width < _minSize && particle.height < _minSize)
+		return false;
+	if(_minAlpha > 0) {
+		ofxParticleInstance instance;
+		particle.fillInstance(instance);
+		if(instance.a < _minAlpha)
+			return false;
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+bool ofxParticleLOD::shouldUpdate(ofxParticle& particle, unsigned int index) {
+	if(_level < 2 || !isLowPriority(particle))
+		return true;
+	unsigned int interval = _level >= 3 ? 4 : 2;
+	return (index + _frame) % interval == 0;
+}
+
+//--------------------------------------------------------------
+float ofxParticleLOD::getSpawnScale() {
+	if(_level >= 4) return 0.25f;
+	if(_level >= 3) return 0.5f;
+	return 1;
+}
+
+//--------------------------------------------------------------
+void ofxParticleLOD::setLevel(int level) {
+	_level = ofClamp(level, 0, _maxLevel);
+	_overFrames = _underFrames = 0;
+	if(_level == 0) {
+		_reasons = NONE;
+	}
+}
+
+void ofxParticleLOD::setMaxLevel(int level) {
+	_maxLevel = ofClamp(level, 0, MAX_LEVEL);
+	if(_level > _maxLevel) {
+		_level = _maxLevel;
+	}
+}
+
+//--------------------------------------------------------------
+std::string ofxParticleLOD::getReasonsString() {
+	std::string s;
+	if(_reasons & UPDATE_TIME) s += "update ";
+	if(_reasons & DRAW_TIME)   s += "draw ";
+	if(_reasons & FRAME_TIME)  s += "frame ";
+	if(s.empty()) return "none";
+	s.erase(s.size()-1); // trailing space
+	return s;
+}
+
+/* ***** PRIVATE ***** */
+
+//--------------------------------------------------------------
+bool ofxParticleLOD::isLowPriority(ofxParticle& particle) {
+	if(particle.getAgeN() > _oldAge)
+		return true;
+	if(_focusDistance > 0) {
+		float dx = particle.x + particle.width * 0.5f - _focus.x;
+		float dy = particle.y + particle.height * 0.5f - _focus.y;
+		return dx * dx + dy * dy > _focusDistance * _focusDistance;
+	}
+	return false;
+}
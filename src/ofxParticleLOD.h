@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#pragma once
+
+#include <string>
+
+#include "ofVectorMath.h"
+
+#include "ofxParticle.h"
+
+/**
+	\class  ParticleLOD
+	\brief  a frame budget governor that lowers particle detail when frames run long
+
+	measures the particle manager's update & draw times against budgets &
+	the app frame time against a target, then raises the level of detail
+	(LOD) level one step at a time while over budget & lowers it again once
+	there is headroom:
+
+	- level 1: skip drawing particles smaller than the min size or more
+	           transparent than the min alpha
+	- level 2: also update far (from the focus point) or old particles every
+	           other frame, particles keep aging correctly as their age is timed
+	- level 3: also update them every 4th frame & halve the emitter rates
+	- level 4: also quarter the emitter rates
+
+	levels change only after being over budget for a number of frames or
+	with headroom for a (larger) number of frames to avoid flickering
+	between levels, there is headroom when the update & draw times are
+	under their budget * recover ratio & the frame time is on target
+**/
+class ofxParticleLOD {
+	public:
+
+		/// why the level was raised, a bitmask
+		enum Reason {
+			NONE        = 0,
+			UPDATE_TIME = 1, ///< update took longer than the update budget
+			DRAW_TIME   = 2, ///< draw took longer than the draw budget
+			FRAME_TIME  = 4  ///< the app frame took longer than the target
+		};
+
+		/// highest level
+		static const int MAX_LEVEL = 4;
+
+		ofxParticleLOD();
+
+	/// \section Budgets (in ms, 0 disables)
+
+		/// target app frame time, compared against the last frame time
+		/// plus 10% to allow for timing jitter, default 1000/60
+		void setTargetFrameTime(float ms) {_targetFrameTime = ms;}
+		float getTargetFrameTime()        {return _targetFrameTime;}
+
+		/// manager update & draw budgets, default 4 ms each
+		void setUpdateBudget(float ms) {_updateBudget = ms;}
+		float getUpdateBudget()        {return _updateBudget;}
+		void setDrawBudget(float ms)   {_drawBudget = ms;}
+		float getDrawBudget()          {return _drawBudget;}
+
+		/// number of frames over budget before raising the level (default 10)
+		/// & with headroom before lowering it (default 60)
+		void setHysteresis(unsigned int framesUp, unsigned int framesDown);
+
+		/// headroom is when the update & draw times are below their budget *
+		/// this ratio & the frame time is within the target, default 0.75
+		void setRecoverRatio(float ratio) {_recoverRatio = ratio;}
+		float getRecoverRatio()           {return _recoverRatio;}
+
+	/// \section Thresholds
+
+		/// particles with a width & height smaller than this are culled at
+		/// level 1+, default 2 px
+		void setMinSize(float size) {_minSize = size;}
+		float getMinSize()          {return _minSize;}
+
+		/// particles with an alpha (from fillInstance) below this are culled
+		/// at level 1+, default 0.05, 0 skips the alpha check
+		void setMinAlpha(float alpha) {_minAlpha = alpha;}
+		float getMinAlpha()           {return _minAlpha;}
+
+		/// particles with a normalized age above this are updated less at
+		/// level 2+, default 0.75
+		void setOldAge(float ageN) {_oldAge = ageN;}
+		float getOldAge()          {return _oldAge;}
+
+		/// particles further than a distance from the focus point are updated
+		/// less at level 2+, a distance of 0 disables this (default)
+		void setFocus(const ofVec2f& point, float distance) {
+			_focus = point;
+			_focusDistance = distance;
+		}
+		const ofVec2f& getFocus() {return _focus;}
+		float getFocusDistance()  {return _focusDistance;}
+
+	/// \section Measure & Evaluate
+
+		/// time the manager update & draw, called by ofxParticleManager
+		void beginUpdate();
+		void endUpdate();
+		void beginDraw();
+		void endDraw();
+
+		/// check the last measurements & change the level if needed,
+		/// called by ofxParticleManager at the start of each update
+		void evaluate();
+
+		/// evaluate with a given app frame time in ms instead of the last
+		/// frame time, ie to drive the governor from your own clock
+		void evaluate(float frameTime);
+
+		/// go back to level 0 & clear the measurements
+		void reset();
+
+	/// \section Apply
+
+		/// should a particle be drawn at the current level?
+		bool shouldDraw(ofxParticle& particle);
+
+		/// should a particle be updated this frame at the current level?
+		/// index is used to stagger the updates across frames
+		bool shouldUpdate(ofxParticle& particle, unsigned int index);
+
+		/// emitter rate scale at the current level, 0-1
+		float getSpawnScale();
+
+	/// \section Status
+
+		/// current level, 0 is full detail
+		int getLevel() {return _level;}
+
+		/// force a level, note: evaluate() keeps changing it
+		void setLevel(int level);
+
+		/// set the max level (default MAX_LEVEL)
+		void setMaxLevel(int level);
+		int getMaxLevel() {return _maxLevel;}
+
+		/// the reasons for the current level, NONE at level 0
+		unsigned int getReasons() {return _reasons;}
+
+		/// the reasons as a readable string, ie "update draw"
+		std::string getReasonsString();
+
+		/// is anything over budget right now?
+		bool isOverBudget() {return _overReasons != NONE;}
+
+		/// smoothed update, draw, & frame times in ms
+		float getUpdateTime() {return _updateTime;}
+		float getDrawTime()   {return _drawTime;}
+		float getFrameTime()  {return _frameTime;}
+
+	private:
+
+		/// is this particle far from the focus or old?
+		bool isLowPriority(ofxParticle& particle);
+
+		float _targetFrameTime, _updateBudget, _drawBudget; ///< budgets in ms
+		unsigned int _framesUp, _framesDown; ///< hysteresis
+		float _recoverRatio; ///< headroom ratio
+
+		float _minSize, _minAlpha, _oldAge; ///< thresholds
+		ofVec2f _focus;        ///< focus point
+		float _focusDistance;  ///< focus distance, 0 if unused
+
+		int _level, _maxLevel;      ///< current & max level
+		unsigned int _reasons;      ///< reasons for the current level
+		unsigned int _overReasons;  ///< reasons over budget right now
+		unsigned int _overFrames, _underFrames; ///< consecutive frame counts
+		unsigned int _frame;        ///< frame counter for staggering
+
+		unsigned long long _updateStart, _drawStart; ///< timestamps in us
+		float _updateTime, _drawTime, _frameTime;   ///< smoothed times in ms
+		bool _bMeasured; ///< has anything been measured since reset?
+};
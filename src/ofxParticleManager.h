@@ -10,40 +10,112 @@
  */
 #pragma once
 
+#include <algorithm>
+
 #include "ofxParticle.h"
+#include "ofxParticleBatch.h"
+#include "ofxParticleGrid.h"
+#include "ofxParticleSweep.h"
+#include "ofxParticleEmitter.h"
+#include "ofxParticleLOD.h"
+#include "ofxParticleSorter.h"
+#include "ofxParticleTrails.h"
 
 /**
 	\class  ofxParticleManager
 	\brief  base class that creates, manages, and destroys particles
+
+	set batchDraw to draw all particles with a single draw call using
+	ofxParticle::fillInstance instead of calling each particle's draw()
+
+	set spatialIndex to keep an ofxParticleGrid of the particle rects updated
+	after each update() for range, radius, nearest, & pair queries
+
+	set overlaps to find the overlapping particle pairs after each update()
+	with an ofxParticleSweep broadphase
+
+	emitters added to the manager spawn particles at the start of each update,
+	set a budget to bound the number of particles when the emitters push
+	too hard
+
+	set adaptiveLOD to have an ofxParticleLOD governor time update() & draw()
+	& reduce the detail when they run over budget
+
+	particles get an id when added & the manager counts update frames, so
+	ofxParticle::getRandom() & the emitter random streams give the same
+	numbers for the same seed, see setRandomSeed()
+
+	set trails to keep the last positions of each particle in an
+	ofxParticleTrails, use buildRibbons() to turn them into a mesh
+
+	save a snapshot to capture the particles, emitters, & random state &
+	load it later to continue from there, override createParticle() to
+	restore your particle classes
+
+	set a draw order to draw the particles sorted by age or by
+	ofxParticle::getDrawKey() instead of in the order they were added
 **/
 class ofxParticleManager {
 	public:
 
-		ofxParticleManager(bool autoRemove=true) : bAutoRemove(autoRemove) {}
+		/// what to do with new particles when the budget is full
+		enum BudgetPolicy {
+			DROP_NEWEST,    ///< don't add new particles over the hard budget
+			RECYCLE_OLDEST, ///< delete the oldest particles to make room, an
+			                ///< emit bigger than the hard budget drops the rest
+			SCALE_RATE      ///< scale the emitter rates down from 1 at the soft
+			                ///< budget to 0 at the hard budget, drop the rest
+		};
+
+		/// the order particles are drawn in, first drawn is at the back
+		enum DrawOrder {
+			DRAW_INSERTION, ///< the order they were added (default)
+			DRAW_AGE,       ///< oldest first, new particles on top
+			DRAW_KEY        ///< lowest ofxParticle::getDrawKey() first
+		};
+
+		ofxParticleManager(bool autoRemove=true) :
+			bAutoRemove(autoRemove), bBatchDraw(false), bSpatialIndex(false), bOverlaps(false),
+			bTrails(false),
+			softBudget(0), hardBudget(0), budgetPolicy(DROP_NEWEST), bAdaptiveLOD(false),
+			drawOrder(DRAW_INSERTION), randomSeed(0),
+			_spawned(0), _killed(0), _dropped(0),
+			_numSpawned(0), _numKilled(0), _numDropped(0), _frame(0), _nextId(0) {}
 		virtual ~ofxParticleManager() {
 			clear(); // cleanup
+			clearEmitters();
 		}
 
 	/// \section Particle Conctrol
 
-		/// add a particle to the particle list,
-		/// note: the particle will be destroyed by this object
+		/// add a particle to the particle list, applies the budget
+		/// note: the particle will be destroyed by this object, even if it
+		///       is dropped due to the budget
 		void addParticle(ofxParticle* particle) {
 			if(particle == NULL) {
 				ofLogWarning("ofxParticleManager") << "cannot add NULL particle";
 				return;
 			}
+			if(!_makeRoom()) {
+				delete particle;
+				return;
+			}
+			particle->setId(_nextId++);
+			particle->setRandomFrame(randomSeed, _frame);
 			particleList.push_back(particle);
+			_spawned++;
 		}
 		
 		void popOldestParticle() {
 			if(!particleList.empty()) {
+				_releaseTrail(particleList.front());
 				particleList.erase(particleList.begin());
 			}
 		}
 		
 		void popNewestParticle() {
 			if(!particleList.empty()) {
+				_releaseTrail(particleList.back());
 				particleList.pop_back();
 			}
 		}
@@ -57,16 +129,281 @@ class ofxParticleManager {
 				}
 			}
 			particleList.clear();
+			grid.clear();
+			sweep.clear();
+			trails.clear();
 		}
 		
 		/// automatically remove (delete) dead particles?
 		inline bool getAutoRemove() {return bAutoRemove;}
 		void setAutoRemove(bool yesno) {bAutoRemove = yesno;}
 		
+	/// \section Emitters
+
+		/// add an emitter, spawns particles during update()
+		/// note: the emitter will be destroyed by this object
+		void addEmitter(ofxParticleEmitter* emitter) {
+			if(emitter == NULL) {
+				ofLogWarning("ofxParticleManager") << "cannot add NULL emitter";
+				return;
+			}
+			if(emitterList.empty()) {
+				emitTimer.set();
+			}
+			emitterList.push_back(emitter);
+		}
+
+		/// remove & delete an emitter
+		void removeEmitter(ofxParticleEmitter* emitter) {
+			std::vector<ofxParticleEmitter*>::iterator iter =
+				std::find(emitterList.begin(), emitterList.end(), emitter);
+			if(iter != emitterList.end()) {
+				delete (*iter);
+				emitterList.erase(iter);
+			}
+		}
+
+		/// remove & delete all emitters
+		void clearEmitters() {
+			for(unsigned int i = 0; i < emitterList.size(); ++i) {
+				delete emitterList[i];
+			}
+			emitterList.clear();
+		}
+
+		/// spawn particles from all emitters for the time since the last
+		/// call, called automatically at the start of update()
+		void emit() {
+			if(emitterList.empty())
+				return;
+
+			// ignore long gaps between frames, same as the particle age
+			unsigned int diff = emitTimer.getDiff();
+			emitTimer.set();
+			if(diff >= ofxParticle::getFrameTimeout())
+				return;
+			float seconds = diff / 1000.0f;
+
+			float scale = getRateScale();
+			if(bAdaptiveLOD) {
+				scale *= lod.getSpawnScale();
+			}
+
+			// count first so RECYCLE_OLDEST makes room in a single pass,
+			// spawns past the hard budget in one step are dropped
+			unsigned int total = 0;
+			_emitCounts.resize(emitterList.size());
+			for(unsigned int i = 0; i < emitterList.size(); ++i) {
+				_emitCounts[i] = emitterList[i]->emit(seconds, scale);
+				total += _emitCounts[i];
+			}
+			if(budgetPolicy == RECYCLE_OLDEST && hardBudget > 0 &&
+			   particleList.size() + total > hardBudget) {
+				_recycleOldest(particleList.size() + total - hardBudget);
+			}
+
+			for(unsigned int i = 0; i < emitterList.size(); ++i) {
+				// emitter streams use ids counting down from the top
+				emitterList[i]->getRandom() = getRandom(0xFFFFFFFF - i);
+				unsigned int count = _emitCounts[i];
+				for(unsigned int j = 0; j < count; ++j) {
+					if(!_makeRoom(false)) {
+						_dropped += count - j - 1; // no need to create the rest
+						break;
+					}
+					ofxParticle* particle = emitterList[i]->spawn();
+					if(particle != NULL) {
+						particle->setId(_nextId++);
+						particle->setRandomFrame(randomSeed, _frame);
+						particleList.push_back(particle);
+						_spawned++;
+					}
+				}
+			}
+		}
+
+		/// number of emitters
+		unsigned int getNumEmitters() {return emitterList.size();}
+
+	/// \section Budget
+
+		/// set the soft & hard particle budgets, 0 is unlimited (default),
+		/// the soft budget is only used by the SCALE_RATE policy
+		void setBudget(unsigned int soft, unsigned int hard) {
+			softBudget = soft;
+			hardBudget = hard;
+		}
+		inline unsigned int getSoftBudget() {return softBudget;}
+		inline unsigned int getHardBudget() {return hardBudget;}
+
+		/// get/set what to do when the budget is full (default DROP_NEWEST)
+		inline BudgetPolicy getBudgetPolicy() {return budgetPolicy;}
+		void setBudgetPolicy(BudgetPolicy policy) {budgetPolicy = policy;}
+
+		/// the current emitter rate scale, 0-1, from the SCALE_RATE policy
+		float getRateScale() {
+			if(budgetPolicy != SCALE_RATE || hardBudget == 0 ||
+			   particleList.size() <= softBudget) {
+				return 1;
+			}
+			if(particleList.size() >= hardBudget || softBudget >= hardBudget) {
+				return 0;
+			}
+			return 1.0f - (float) (particleList.size() - softBudget) /
+			              (float) (hardBudget - softBudget);
+		}
+
+	/// \section Stats (for the last update)
+
+		/// number of particles added, includes emitted & addParticle()
+		unsigned int getNumSpawned() {return _numSpawned;}
+
+		/// number of particles removed, includes dead & recycled particles
+		unsigned int getNumKilled()  {return _numKilled;}
+
+		/// number of new particles dropped due to the budget
+		unsigned int getNumDropped() {return _numDropped;}
+
+	/// \section Random
+
+		/// set the seed for the particle & emitter random streams, resets the
+		/// frame count & particle ids so a run can be repeated (default 0)
+		void setRandomSeed(unsigned long long seed) {
+			randomSeed = seed;
+			_frame = 0;
+			_nextId = 0;
+		}
+		inline unsigned long long getRandomSeed() {return randomSeed;}
+
+		/// get the random stream for an id & the current frame
+		ofxParticleRandom getRandom(unsigned int id) {
+			return ofxParticleRandom(randomSeed, id, _frame);
+		}
+
+		/// the number of updates since the seed was set
+		inline unsigned int getFrame() {return _frame;}
+
+	/// \section Snapshot
+
+		/// create an empty particle of a snapshot type for loadSnapshot(),
+		/// see ofxParticle::getSnapshotType(), return NULL to skip the type
+		virtual ofxParticle* createParticle(unsigned int type) {return NULL;}
+
+		/// write the particles, the emitter state, & the random state to a
+		/// snapshot, clears the snapshot first
+		void saveSnapshot(ofxParticleSnapshot& snapshot) {
+			snapshot.clear();
+			snapshot.write(randomSeed);
+			snapshot.write(_frame);
+			snapshot.write(_nextId);
+
+			snapshot.write((unsigned int) emitterList.size());
+			for(unsigned int i = 0; i < emitterList.size(); ++i) {
+				unsigned int pos = snapshot.beginRecord(0);
+				emitterList[i]->save(snapshot);
+				snapshot.endRecord(pos);
+			}
+
+			unsigned int num = 0;
+			for(unsigned int i = 0; i < particleList.size(); ++i) {
+				if(particleList[i] != NULL) {
+					num++;
+				}
+			}
+			snapshot.write(num);
+			for(unsigned int i = 0; i < particleList.size(); ++i) {
+				ofxParticle* p = particleList[i];
+				if(p != NULL) {
+					unsigned int pos = snapshot.beginRecord(p->getSnapshotType());
+					p->save(snapshot);
+					snapshot.endRecord(pos);
+				}
+			}
+		}
+
+		/// replace the particles & restore the emitter & random state from a
+		/// snapshot, the emitters must already be added in the same order,
+		/// returns false if the snapshot is incomplete
+		bool loadSnapshot(ofxParticleSnapshot& snapshot) {
+			snapshot.rewind();
+			clear();
+			unsigned int type, size, num = 0;
+			snapshot.read(randomSeed);
+			snapshot.read(_frame);
+			snapshot.read(_nextId);
+
+			snapshot.read(num);
+			for(unsigned int i = 0; i < num && snapshot.readRecord(type, size) &&
+			    snapshot.canRead(1, size); ++i) {
+				unsigned int end = snapshot.tell() + size;
+				if(i < emitterList.size()) {
+					emitterList[i]->load(snapshot);
+				}
+				_skipTo(snapshot, end);
+			}
+			if(num != emitterList.size()) {
+				ofLogWarning("ofxParticleManager") << "loadSnapshot(): snapshot has " << num
+					<< " emitters, manager has " << emitterList.size();
+			}
+
+			num = 0;
+			snapshot.read(num);
+			unsigned int skipped = 0;
+			for(unsigned int i = 0; i < num && snapshot.readRecord(type, size) &&
+			    snapshot.canRead(1, size); ++i) {
+				unsigned int end = snapshot.tell() + size;
+				ofxParticle* p = createParticle(type);
+				if(p == NULL) {
+					skipped++;
+				}
+				else if(p->load(snapshot)) {
+					particleList.push_back(p);
+				}
+				else {
+					delete p;
+				}
+				_skipTo(snapshot, end);
+			}
+			if(skipped > 0) {
+				ofLogWarning("ofxParticleManager") << "loadSnapshot(): skipped " << skipped
+					<< " particles createParticle() didn't create";
+			}
+
+			emitTimer.set();
+			if(bSpatialIndex) {
+				updateGrid();
+			}
+			if(!snapshot.isGood()) {
+				ofLogWarning("ofxParticleManager") << "loadSnapshot(): snapshot is incomplete";
+				return false;
+			}
+			return true;
+		}
+
+	/// \section Adaptive LOD
+
+		/// reduce the detail when the update & draw times run over budget?
+		/// (off by default)
+		inline bool getAdaptiveLOD() {return bAdaptiveLOD;}
+		void setAdaptiveLOD(bool yesno) {
+			bAdaptiveLOD = yesno;
+			lod.reset();
+		}
+
+		/// the LOD governor, use this to set the budgets & thresholds or
+		/// read the current level & reasons
+		ofxParticleLOD& getLOD() {return lod;}
+
 	/// \section Update & Draw
 
 		/// update all particles
 		virtual void update() {
+			if(bAdaptiveLOD) {
+				lod.evaluate();
+				lod.beginUpdate();
+			}
+			emit();
+			unsigned int index = 0;
 			std::vector<ofxParticle*> ::iterator iter;
 			for(iter = particleList.begin(); iter != particleList.end();) {
 				// remove particle if it's NULL
@@ -77,34 +414,247 @@ class ofxParticleManager {
 				else {
 					// auto remove dead particles?
 					if(bAutoRemove && !(*iter)->isAlive()) {
+						_releaseTrail(*iter);
 						delete (*iter);
 						iter = particleList.erase(iter);
+						_killed++;
 					}
 					else {
-						(*iter)->update();
+						if(!bAdaptiveLOD || lod.shouldUpdate(**iter, index)) {
+							(*iter)->setRandomFrame(randomSeed, _frame);
+							(*iter)->update();
+						}
 						++iter; // increment iter
+						++index;
 					}
 				}
 			}
 
+			if(bTrails) {
+				updateTrails();
+			}
+			if(bSpatialIndex) {
+				updateGrid();
+			}
+			if(bOverlaps) {
+				updateOverlaps();
+			}
+			if(bAdaptiveLOD) {
+				lod.endUpdate();
+			}
+
+			_frame++;
+
+			// publish this frame's stats
+			_numSpawned = _spawned;
+			_numKilled = _killed;
+			_numDropped = _dropped;
+			_spawned = _killed = _dropped = 0;
 		}
 
 		/// draw all the particles
 		virtual void draw() {
-			std::vector<ofxParticle*> ::iterator iter;
-			for(iter = particleList.begin(); iter != particleList.end();){
-				// remove particle if it's NULL
-				if((*iter) == NULL) {
-					ofLogWarning("ofxParticleManager") << "draw(): removing NULL particle";
-					iter = particleList.erase(iter);
+			if(bAdaptiveLOD) {
+				lod.beginDraw();
+			}
+			if(drawOrder != DRAW_INSERTION) {
+				_sortParticles();
+			}
+			if(bBatchDraw) {
+				bool cull = bAdaptiveLOD && lod.getLevel() > 0;
+				if(cull || drawOrder != DRAW_INSERTION) {
+					_drawList.clear();
+					for(unsigned int i = 0; i < particleList.size(); ++i) {
+						ofxParticle* p = particleList[_drawIndex(i)];
+						if(p != NULL && (!cull || lod.shouldDraw(*p))) {
+							_drawList.push_back(p);
+						}
+					}
+					batch.build(_drawList);
 				}
 				else {
-					(*iter)->draw();
-					++iter; // increment iter
+					batch.build(particleList);
 				}
+				batch.draw();
+			}
+			else {
+				_drawParticles();
+			}
+			if(bAdaptiveLOD) {
+				lod.endDraw();
 			}
 		}
 		
+	/// \section Draw Order
+
+		/// the order particles are drawn in (default DRAW_INSERTION)
+		inline DrawOrder getDrawOrder() {return drawOrder;}
+		void setDrawOrder(DrawOrder order) {
+			drawOrder = order;
+			sorter.clear();
+		}
+
+		/// the sorter used for the draw order, the sorted indices are
+		/// particle list indices from the last draw
+		ofxParticleSorter& getSorter() {return sorter;}
+
+	/// \section Batch Drawing
+
+		/// draw all particles in a single batch? (off by default)
+		inline bool getBatchDraw() {return bBatchDraw;}
+		void setBatchDraw(bool yesno) {bBatchDraw = yesno;}
+
+		/// the batch used when drawing, use this to set a texture or
+		/// read the build & draw times
+		ofxParticleBatch& getBatch() {return batch;}
+
+	/// \section Spatial Index
+
+		/// keep the particle grid updated? (off by default)
+		inline bool getSpatialIndex() {return bSpatialIndex;}
+		void setSpatialIndex(bool yesno) {
+			bSpatialIndex = yesno;
+			if(bSpatialIndex) {
+				updateGrid();
+			}
+			else {
+				grid.clear();
+			}
+		}
+
+		/// the particle grid, the item indices are particle list indices
+		/// & are valid until the next update(), add, or pop
+		ofxParticleGrid& getGrid() {return grid;}
+
+		/// get the particles overlapping an area
+		void getParticlesIn(const ofRectangle& area, std::vector<ofxParticle*>& particles) {
+			grid.queryRange(area, _indices);
+			_toParticles(_indices, particles);
+		}
+
+		/// get the particles within a radius of a point
+		void getParticlesNear(const ofVec2f& point, float radius, std::vector<ofxParticle*>& particles) {
+			grid.queryRadius(point, radius, _indices);
+			_toParticles(_indices, particles);
+		}
+
+		/// get the k particles closest to a point, nearest first
+		void getNearestParticles(const ofVec2f& point, unsigned int k, std::vector<ofxParticle*>& particles) {
+			grid.queryNearest(point, k, _indices);
+			_toParticles(_indices, particles);
+		}
+
+		/// get the particle containing a point that was drawn on top, returns
+		/// NULL if none
+		ofxParticle* getParticleAt(float x, float y) {
+			grid.queryPoint(x, y, _indices);
+			if(_indices.empty())
+				return NULL;
+			if(drawOrder != DRAW_INSERTION && sorter.size() == particleList.size()) {
+				// last in the draw order
+				for(int i = sorter.size()-1; i >= 0; --i) {
+					if(std::find(_indices.begin(), _indices.end(), sorter[i]) != _indices.end()) {
+						return particleList[sorter[i]];
+					}
+				}
+			}
+			return particleList[*std::max_element(_indices.begin(), _indices.end())];
+		}
+
+		/// rebuild the grid from the particle list, called automatically after
+		/// update() when spatialIndex is set, only particles that moved to
+		/// different cells are relinked
+		void updateGrid() {
+			for(unsigned int i = 0; i < particleList.size(); ++i) {
+				if(particleList[i] != NULL) {
+					grid.update(i, *particleList[i]);
+				}
+				else {
+					grid.remove(i);
+				}
+			}
+			grid.resize(particleList.size());
+		}
+
+	/// \section Overlaps
+
+		/// find the overlapping particle pairs after each update()? (off by
+		/// default), use this for particle particle collisions
+		inline bool getOverlaps() {return bOverlaps;}
+		void setOverlaps(bool yesno) {
+			bOverlaps = yesno;
+			if(!bOverlaps) {
+				sweep.clear();
+			}
+		}
+
+		/// the sort & sweep broadphase, add a listener to be notified of each
+		/// pair, the item indices are particle list indices
+		ofxParticleSweep& getSweep() {return sweep;}
+
+		/// the overlapping pairs from the last update, first < second
+		const std::vector<ofxParticleSweep::Pair>& getOverlappingPairs() {
+			return sweep.getPairs();
+		}
+
+		/// sync the broadphase with the particle list & find the overlapping
+		/// pairs, called automatically after update() when overlaps is set
+		void updateOverlaps() {
+			for(unsigned int i = 0; i < particleList.size(); ++i) {
+				if(particleList[i] != NULL) {
+					sweep.update(i, *particleList[i]);
+				}
+				else {
+					sweep.remove(i);
+				}
+			}
+			sweep.resize(particleList.size());
+			sweep.findPairs();
+		}
+
+	/// \section Trails
+
+		/// record the particle positions after each update()? (off by default)
+		inline bool getTrails() {return bTrails;}
+		void setTrails(bool yesno) {
+			bTrails = yesno;
+			if(!bTrails) {
+				for(unsigned int i = 0; i < particleList.size(); ++i) {
+					_releaseTrail(particleList[i]);
+				}
+			}
+		}
+
+		/// the trail slab, use this to set the trail length or read a trail
+		/// with a particle's ofxParticle::getTrail() slot
+		ofxParticleTrails& getTrailBuffers() {return trails;}
+
+		/// clear a mesh & add a ribbon for each particle's trail
+		void buildRibbons(ofMesh& mesh, float width, bool taper=true) {
+			mesh.clear();
+			mesh.setMode(OF_PRIMITIVE_TRIANGLES);
+			for(unsigned int i = 0; i < particleList.size(); ++i) {
+				if(particleList[i] != NULL) {
+					trails.addRibbon(particleList[i]->getTrail(), width, mesh, taper);
+				}
+			}
+		}
+
+		/// add the particle centers to their trails, called automatically
+		/// after update() when trails is set
+		void updateTrails() {
+			for(unsigned int i = 0; i < particleList.size(); ++i) {
+				ofxParticle* p = particleList[i];
+				if(p == NULL) {
+					continue;
+				}
+				if(p->getTrail() == ofxParticleTrails::NO_SLOT) {
+					p->setTrail(trails.allocate());
+				}
+				trails.push(p->getTrail(), p->x + p->width/2, p->y + p->height/2);
+			}
+		}
+
 	/// \section Util
 		
 		// get the number of particles
@@ -120,6 +670,147 @@ class ofxParticleManager {
 	protected:
 
 		bool bAutoRemove; ///< automatically remove dead particles?
+		bool bBatchDraw;  ///< draw particles in a batch?
 
 		std::vector<ofxParticle*> particleList; ///< current particles
+
+		bool bSpatialIndex; ///< update the particle grid?
+		bool bOverlaps;     ///< find overlapping pairs?
+		bool bTrails;       ///< record particle trails?
+
+		unsigned int softBudget, hardBudget; ///< particle budgets, 0 is unlimited
+		BudgetPolicy budgetPolicy;           ///< what to do when over budget
+
+		ofxParticleBatch batch; ///< batched particle vertices
+		ofxParticleGrid grid;   ///< particle spatial index
+		ofxParticleSweep sweep; ///< overlap broadphase
+		ofxParticleTrails trails; ///< particle position history
+
+		std::vector<ofxParticleEmitter*> emitterList; ///< current emitters
+		ofxTimer emitTimer; ///< times the emitter steps
+
+		bool bAdaptiveLOD;  ///< reduce detail when over budget?
+		ofxParticleLOD lod; ///< LOD governor
+
+		DrawOrder drawOrder;      ///< particle draw order
+		ofxParticleSorter sorter; ///< sorts the draw order
+
+		unsigned long long randomSeed; ///< random stream seed
+
+	private:
+
+		/// draw each particle, skips particles culled by the LOD
+		void _drawParticles() {
+			bool cull = bAdaptiveLOD && lod.getLevel() > 0;
+			if(drawOrder != DRAW_INSERTION) { // NULLs were removed when sorting
+				for(unsigned int i = 0; i < particleList.size(); ++i) {
+					ofxParticle* p = particleList[_drawIndex(i)];
+					if(!cull || lod.shouldDraw(*p)) {
+						p->draw();
+					}
+				}
+				return;
+			}
+			std::vector<ofxParticle*> ::iterator iter;
+			for(iter = particleList.begin(); iter != particleList.end();){
+				// remove particle if it's NULL
+				if((*iter) == NULL) {
+					ofLogWarning("ofxParticleManager") << "draw(): removing NULL particle";
+					iter = particleList.erase(iter);
+				}
+				else {
+					if(!cull || lod.shouldDraw(**iter)) {
+						(*iter)->draw();
+					}
+					++iter; // increment iter
+				}
+			}
+		}
+
+		/// remove NULL particles & sort the draw order
+		void _sortParticles() {
+			if(std::find(particleList.begin(), particleList.end(), (ofxParticle*) NULL) != particleList.end()) {
+				ofLogWarning("ofxParticleManager") << "draw(): removing NULL particles";
+				particleList.erase(std::remove(particleList.begin(), particleList.end(), (ofxParticle*) NULL), particleList.end());
+			}
+			_drawKeys.resize(particleList.size());
+			for(unsigned int i = 0; i < particleList.size(); ++i) {
+				_drawKeys[i] = (drawOrder == DRAW_AGE) ? -particleList[i]->getAge() : particleList[i]->getDrawKey();
+			}
+			sorter.sort(_drawKeys);
+		}
+
+		/// particle list index for a draw position
+		inline unsigned int _drawIndex(unsigned int i) {
+			return drawOrder == DRAW_INSERTION ? i : sorter[i];
+		}
+
+		/// give a particle's trail slot back
+		void _releaseTrail(ofxParticle* particle) {
+			if(particle != NULL && particle->getTrail() != ofxParticleTrails::NO_SLOT) {
+				trails.release(particle->getTrail());
+				particle->setTrail(ofxParticleTrails::NO_SLOT);
+			}
+		}
+
+		/// move the snapshot read position to the end of a record
+		void _skipTo(ofxParticleSnapshot& snapshot, unsigned int end) {
+			if(snapshot.tell() > end) {
+				ofLogWarning("ofxParticleManager") << "loadSnapshot(): read past the end of a record";
+				snapshot.rewind();
+				snapshot.skip(end);
+			}
+			else {
+				snapshot.skip(end - snapshot.tell());
+			}
+		}
+
+		/// make room for a new particle according to the budget policy,
+		/// recycle = false drops instead of recycling, returns false &
+		/// counts a drop if there is no room
+		bool _makeRoom(bool recycle=true) {
+			if(hardBudget == 0 || particleList.size() < hardBudget) {
+				return true;
+			}
+			if(recycle && budgetPolicy == RECYCLE_OLDEST) {
+				_recycleOldest(particleList.size() - hardBudget + 1);
+				return true;
+			}
+			_dropped++;
+			return false;
+		}
+
+		/// delete a number of the oldest particles with a single erase
+		void _recycleOldest(unsigned int count) {
+			if(count > particleList.size()) {
+				count = particleList.size();
+			}
+			for(unsigned int i = 0; i < count; ++i) {
+				_releaseTrail(particleList[i]);
+				delete particleList[i];
+			}
+			particleList.erase(particleList.begin(), particleList.begin()+count);
+			_killed += count;
+		}
+
+		/// convert grid indices into particles
+		void _toParticles(const std::vector<unsigned int>& indices, std::vector<ofxParticle*>& particles) {
+			particles.clear();
+			for(unsigned int i = 0; i < indices.size(); ++i) {
+				if(indices[i] < particleList.size() && particleList[indices[i]] != NULL) {
+					particles.push_back(particleList[indices[i]]);
+				}
+			}
+		}
+
+		std::vector<unsigned int> _indices; ///< query scratch space
+		std::vector<ofxParticle*> _drawList; ///< particles left after LOD culling
+		std::vector<float> _drawKeys;        ///< draw order sort keys
+		std::vector<unsigned int> _emitCounts; ///< particles to spawn per emitter
+
+		unsigned int _spawned, _killed, _dropped;  ///< this frame's counts
+		unsigned int _numSpawned, _numKilled, _numDropped; ///< last frame's counts
+
+		unsigned int _frame;  ///< updates since the seed was set
+		unsigned int _nextId; ///< next particle id
 };
@@ -0,0 +1,430 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#pragma once
+
+#include <vector>
+
+#include "ofxParticle.h"
+#include "ofxParticleGrid.h"
+#include "ofxParticleSweep.h"
+#include "ofxParticlePoint.h"
+#include "ofxParticleMotion.h"
+#include "ofxParticleTrails.h"
+
+/**
+	\class  ParticleManagerT
+	\brief  a particle manager for a single particle type stored by value
+
+	ofxParticleManager stores pointers to any ofxParticle subclass & calls the
+	virtual update() & draw() for each, this version stores one concrete
+	particle type in a contiguous std::vector & calls P::update() & P::draw()
+	directly so the compiler can inline them:
+
+	    ofxParticleManagerT<MyParticle> particles;
+	    particles.addParticle(MyParticle(x, y, 10, 10));
+
+	P needs a copy constructor, update(), draw(), & isAlive() & is usually an
+	ofxParticle subclass, the API is the same as ofxParticleManager except
+	particles are added & accessed by value
+
+	particles are keyed for random streams by their index & the update frame,
+	see getRandom()
+
+	saveSnapshot() & loadSnapshot() need P to have save() & load() like
+	ofxParticle & a default constructor
+
+	see ofxParticlePoint for a compact particle type & ofxParticleAdapter to
+	use existing ofxParticle subclasses
+
+	note: references to particles are invalidated when particles are added
+	      or removed
+**/
+template <class P>
+class ofxParticleManagerT {
+	public:
+
+		ofxParticleManagerT(bool autoRemove=true) :
+			bAutoRemove(autoRemove), bSpatialIndex(false), bOverlaps(false), bMotion(false), bTrails(false),
+			randomSeed(0), _frame(0) {}
+		virtual ~ofxParticleManagerT() {}
+
+	/// \section Particle Control
+
+		/// add a copy of a particle to the particle list
+		void addParticle(const P& particle) {
+			particleList.push_back(particle);
+			if(bMotion) {
+				motion.addPending();
+			}
+			if(bTrails) {
+				trailSlots.push_back(ofxParticleTrails::NO_SLOT);
+			}
+		}
+
+		/// add a copy of a particle with a starting velocity for the motion
+		/// forces, P needs x & y members
+		void addParticle(const P& particle, float vx, float vy) {
+			particleList.push_back(particle);
+			if(bMotion) {
+				motion.add(particle.x, particle.y, vx, vy);
+			}
+			if(bTrails) {
+				trailSlots.push_back(ofxParticleTrails::NO_SLOT);
+			}
+		}
+
+		void popOldestParticle() {
+			if(!particleList.empty()) {
+				particleList.erase(particleList.begin());
+				if(bMotion) {
+					motion.remove(0);
+				}
+				if(bTrails) {
+					trails.release(trailSlots.front());
+					trailSlots.erase(trailSlots.begin());
+				}
+			}
+		}
+
+		void popNewestParticle() {
+			if(!particleList.empty()) {
+				particleList.pop_back();
+				if(bMotion) {
+					motion.remove(motion.size()-1);
+				}
+				if(bTrails) {
+					trails.release(trailSlots.back());
+					trailSlots.pop_back();
+				}
+			}
+		}
+
+		/// clear all particles in the particle list
+		void clear() {
+			particleList.clear();
+			grid.clear();
+			sweep.clear();
+			motion.clear();
+			trails.clear();
+			trailSlots.clear();
+		}
+
+		/// reserve room for a number of particles to avoid reallocating
+		void reserve(unsigned int size) {
+			particleList.reserve(size);
+		}
+
+		/// automatically remove dead particles?
+		inline bool getAutoRemove() {return bAutoRemove;}
+		void setAutoRemove(bool yesno) {bAutoRemove = yesno;}
+
+	/// \section Update & Draw
+
+		/// update all particles, dead particles are removed in a single pass
+		/// that keeps the order of the live particles
+		virtual void update() {
+			unsigned int write = 0;
+			for(unsigned int read = 0; read < particleList.size(); ++read) {
+				P& p = particleList[read];
+				if(bAutoRemove && !p.isAlive()) {
+					if(bTrails) {
+						trails.release(trailSlots[read]);
+					}
+					continue;
+				}
+				p.P::update(); // static call, no virtual dispatch
+				if(write != read) {
+					particleList[write] = p;
+					if(bMotion) {
+						motion.move(read, write);
+					}
+					if(bTrails) {
+						trailSlots[write] = trailSlots[read];
+					}
+				}
+				++write;
+			}
+			particleList.erase(particleList.begin()+write, particleList.end());
+			if(bMotion) {
+				motion.resize(write);
+			}
+			if(bTrails) {
+				trailSlots.resize(write);
+				updateTrails();
+			}
+
+			if(bSpatialIndex) {
+				updateGrid();
+			}
+			if(bOverlaps) {
+				updateOverlaps();
+			}
+			_frame++;
+		}
+
+		/// draw all the particles
+		virtual void draw() {
+			typename std::vector<P>::iterator iter;
+			for(iter = particleList.begin(); iter != particleList.end(); ++iter) {
+				iter->P::draw(); // static call, no virtual dispatch
+			}
+		}
+
+	/// \section Random
+
+		/// set the seed for the random streams, resets the frame count
+		/// (default 0)
+		void setRandomSeed(unsigned long long seed) {
+			randomSeed = seed;
+			_frame = 0;
+		}
+		inline unsigned long long getRandomSeed() {return randomSeed;}
+
+		/// get the random stream for an id (ie a particle index) & the
+		/// current frame, use this in parallel loops instead of ofRandom()
+		ofxParticleRandom getRandom(unsigned int id) {
+			return ofxParticleRandom(randomSeed, id, _frame);
+		}
+
+		/// the number of updates since the seed was set
+		inline unsigned int getFrame() {return _frame;}
+
+	/// \section Snapshot
+
+		/// write the particles, the motion, & the random state to a snapshot,
+		/// clears the snapshot first
+		void saveSnapshot(ofxParticleSnapshot& snapshot) {
+			snapshot.clear();
+			snapshot.write(randomSeed);
+			snapshot.write(_frame);
+			snapshot.write((unsigned int) particleList.size());
+			for(unsigned int i = 0; i < particleList.size(); ++i) {
+				particleList[i].save(snapshot);
+			}
+			snapshot.write(bMotion);
+			if(bMotion) {
+				motion.save(snapshot);
+			}
+		}
+
+		/// replace the particles & restore the motion & random state from a
+		/// snapshot, returns false if the snapshot is incomplete
+		bool loadSnapshot(ofxParticleSnapshot& snapshot) {
+			snapshot.rewind();
+			clear();
+			unsigned int num = 0;
+			snapshot.read(randomSeed);
+			snapshot.read(_frame);
+			snapshot.read(num);
+			if(snapshot.canRead(num, 1)) { // particles save at least a byte
+				particleList.reserve(num);
+			}
+			for(unsigned int i = 0; i < num && snapshot.isGood(); ++i) {
+				P particle;
+				if(particle.load(snapshot)) {
+					particleList.push_back(particle);
+				}
+			}
+			bool hasMotion = false;
+			snapshot.read(hasMotion);
+			if(hasMotion) {
+				if(bMotion) {
+					motion.load(snapshot); // keeps the forces
+				}
+				else {
+					ofxParticleMotion unused;
+					unused.load(snapshot);
+				}
+			}
+			if(bMotion && motion.size() != particleList.size()) {
+				motion.clear();
+				motion.resize(particleList.size()); // placed on the next update
+			}
+			if(bTrails) {
+				trailSlots.assign(particleList.size(), ofxParticleTrails::NO_SLOT);
+			}
+			if(!snapshot.isGood()) {
+				ofLogWarning("ofxParticleManagerT") << "loadSnapshot(): snapshot is incomplete";
+				particleList.clear();
+				motion.clear();
+				trailSlots.clear();
+				return false;
+			}
+			return true;
+		}
+
+	/// \section Motion
+
+		/// keep a particle motion in sync with the particle list? (off by
+		/// default), add forces with getMotion().addForce()
+		inline bool isMotionEnabled() {return bMotion;}
+		void setMotionEnabled(bool yesno) {
+			bMotion = yesno;
+			motion.clear();
+			if(bMotion) {
+				motion.resize(particleList.size()); // placed on the next update
+			}
+		}
+
+		/// the particle motion, indices are particle list indices
+		ofxParticleMotion& getMotion() {return motion;}
+
+		/// apply the motion forces & move the particles by a time step in
+		/// seconds, uses the frame clock if the step is 0, call this before
+		/// update(), P needs x & y members
+		void updateMotion(float dt=0) {
+			if(!bMotion) {
+				return;
+			}
+			if(dt == 0) {
+				dt = ofxParticlePoint::getFrameTime() / 1000.0;
+			}
+			motion.gather(particleList);
+			motion.update(dt);
+			motion.scatter(particleList);
+		}
+
+	/// \section Trails
+
+		/// record the particle centers after each update()? (off by default)
+		inline bool getTrails() {return bTrails;}
+		void setTrails(bool yesno) {
+			bTrails = yesno;
+			trails.clear();
+			trailSlots.assign(bTrails ? particleList.size() : 0, ofxParticleTrails::NO_SLOT);
+		}
+
+		/// the trail slab, use this to set the trail length
+		ofxParticleTrails& getTrailBuffers() {return trails;}
+
+		/// the trail slot for a particle index
+		unsigned int getTrail(unsigned int index) {
+			return index < trailSlots.size() ? trailSlots[index] : ofxParticleTrails::NO_SLOT;
+		}
+
+		/// clear a mesh & add a ribbon for each particle's trail
+		void buildRibbons(ofMesh& mesh, float width, bool taper=true) {
+			mesh.clear();
+			mesh.setMode(OF_PRIMITIVE_TRIANGLES);
+			for(unsigned int i = 0; i < trailSlots.size(); ++i) {
+				trails.addRibbon(trailSlots[i], width, mesh, taper);
+			}
+		}
+
+		/// add the particle centers to their trails, called automatically
+		/// after update() when trails is set
+		void updateTrails() {
+			for(unsigned int i = 0; i < particleList.size(); ++i) {
+				if(trailSlots[i] == ofxParticleTrails::NO_SLOT) {
+					trailSlots[i] = trails.allocate();
+				}
+				ofRectangle rect = particleList[i];
+				trails.push(trailSlots[i], rect.x + rect.width/2, rect.y + rect.height/2);
+			}
+		}
+
+	/// \section Spatial Index
+
+		/// keep the particle grid updated after each update()? (off by default)
+		inline bool getSpatialIndex() {return bSpatialIndex;}
+		void setSpatialIndex(bool yesno) {
+			bSpatialIndex = yesno;
+			if(bSpatialIndex) {
+				updateGrid();
+			}
+			else {
+				grid.clear();
+			}
+		}
+
+		/// the particle grid, the item indices are particle list indices
+		ofxParticleGrid& getGrid() {return grid;}
+
+		/// rebuild the grid from the particle list, only particles that moved
+		/// to different cells are relinked
+		void updateGrid() {
+			for(unsigned int i = 0; i < particleList.size(); ++i) {
+				grid.update(i, particleList[i]);
+			}
+			grid.resize(particleList.size());
+		}
+
+	/// \section Overlaps
+
+		/// find the overlapping particle pairs after each update()? (off by
+		/// default), use this for particle particle collisions
+		inline bool getOverlaps() {return bOverlaps;}
+		void setOverlaps(bool yesno) {
+			bOverlaps = yesno;
+			if(!bOverlaps) {
+				sweep.clear();
+			}
+		}
+
+		/// the sort & sweep broadphase, add a listener to be notified of each
+		/// pair, the item indices are particle list indices
+		ofxParticleSweep& getSweep() {return sweep;}
+
+		/// the overlapping pairs from the last update, first < second
+		const std::vector<ofxParticleSweep::Pair>& getOverlappingPairs() {
+			return sweep.getPairs();
+		}
+
+		/// sync the broadphase with the particle list & find the overlapping
+		/// pairs, called automatically after update() when overlaps is set
+		void updateOverlaps() {
+			for(unsigned int i = 0; i < particleList.size(); ++i) {
+				sweep.update(i, particleList[i]);
+			}
+			sweep.resize(particleList.size());
+			sweep.findPairs();
+		}
+
+	/// \section Util
+
+		/// particle access by index, no bounds checking
+		inline P& operator[](unsigned int index) {return particleList[index];}
+		inline P& getParticle(unsigned int index) {return particleList[index];}
+
+		/// the particle list
+		std::vector<P>& getParticles() {return particleList;}
+
+		// get the number of particles
+		unsigned int size() {
+			return particleList.size();
+		}
+
+		// are there any particles at all?
+		bool empty() {
+			return particleList.empty();
+		}
+
+	protected:
+
+		bool bAutoRemove;   ///< automatically remove dead particles?
+		bool bSpatialIndex; ///< update the particle grid?
+		bool bOverlaps;     ///< find overlapping pairs?
+		bool bMotion;       ///< keep the motion in sync?
+		bool bTrails;       ///< record particle trails?
+
+		std::vector<P> particleList; ///< current particles, by value
+		ofxParticleGrid grid;        ///< particle spatial index
+		ofxParticleSweep sweep;      ///< overlap broadphase
+		ofxParticleMotion motion;    ///< particle forces & integration
+		ofxParticleTrails trails;    ///< particle position history
+		std::vector<unsigned int> trailSlots; ///< trail slot per particle
+
+		unsigned long long randomSeed; ///< random stream seed
+
+	private:
+
+		unsigned int _frame; ///< updates since the seed was set
+};
@@ -0,0 +1,338 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#include "ofxParticleMotion.h"
+
+#include <cstring>
+
+#include "ofLog.h"
+
+#ifdef __SSE__
+	#include <xmmintrin.h>
+#endif
+
+/// PARTICLE MOTION
+
+//--------------------------------------------------------------
+ofxParticleMotion::ofxParticleMotion() :
+	_integrator(SEMI_IMPLICIT), _chunkSize(1024), _lastDt(1.0/60.0) {}
+
+//--------------------------------------------------------------
+ofxParticleMotion::~ofxParticleMotion() {
+	clearForces();
+}
+
+//--------------------------------------------------------------
+unsigned int ofxParticleMotion::add(float px, float py, float pvx, float pvy) {
+	unsigned int index = addPending(pvx, pvy);
+	_start(index, px, py);
+	return index;
+}
+
+//--------------------------------------------------------------
+unsigned int ofxParticleMotion::addPending(float pvx, float pvy) {
+	x.push_back(0);
+	y.push_back(0);
+	vx.push_back(pvx);
+	vy.push_back(pvy);
+	ax.push_back(0);
+	ay.push_back(0);
+	prevX.push_back(0);
+	prevY.push_back(0);
+	_pending.push_back(true);
+	return x.size()-1;
+}
+
+//--------------------------------------------------------------
+void ofxParticleMotion::remove(unsigned int index) {
+	if(index >= x.size()) {
+		return;
+	}
+	x.erase(x.begin()+index);
+	y.erase(y.begin()+index);
+	vx.erase(vx.begin()+index);
+	vy.erase(vy.begin()+index);
+	ax.erase(ax.begin()+index);
+	ay.erase(ay.begin()+index);
+	prevX.erase(prevX.begin()+index);
+	prevY.erase(prevY.begin()+index);
+	_pending.erase(_pending.begin()+index);
+}
+
+//--------------------------------------------------------------
+void ofxParticleMotion::move(unsigned int from, unsigned int to) {
+	x[to] = x[from];
+	y[to] = y[from];
+	vx[to] = vx[from];
+	vy[to] = vy[from];
+	ax[to] = ax[from];
+	ay[to] = ay[from];
+	prevX[to] = prevX[from];
+	prevY[to] = prevY[from];
+	_pending[to] = _pending[from];
+}
+
+//--------------------------------------------------------------
+void ofxParticleMotion::resize(unsigned int size) {
+	x.resize(size, 0);
+	y.resize(size, 0);
+	vx.resize(size, 0);
+	vy.resize(size, 0);
+	ax.resize(size, 0);
+	ay.resize(size, 0);
+	prevX.resize(size, 0);
+	prevY.resize(size, 0);
+	_pending.resize(size, true);
+}
+
+//--------------------------------------------------------------
+void ofxParticleMotion::clear() {
+	resize(0);
+}
+
+//--------------------------------------------------------------
+void ofxParticleMotion::setPosition(unsigned int index, float px, float py) {
+	if(index < x.size()) {
+		_start(index, px, py);
+	}
+}
+
+//--------------------------------------------------------------
+void ofxParticleMotion::setVelocity(unsigned int index, float pvx, float pvy) {
+	if(index >= x.size()) {
+		return;
+	}
+	vx[index] = pvx;
+	vy[index] = pvy;
+	prevX[index] = x[index] - pvx * _lastDt;
+	prevY[index] = y[index] - pvy * _lastDt;
+}
+
+//--------------------------------------------------------------
+void ofxParticleMotion::addForce(ofxParticleForce* force) {
+	if(force == NULL) {
+		ofLogWarning("ofxParticleMotion") << "cannot add NULL force";
+		return;
+	}
+	_forces.push_back(force);
+}
+
+//--------------------------------------------------------------
+void ofxParticleMotion::removeForce(ofxParticleForce* force) {
+	std::vector<ofxParticleForce*>::iterator iter;
+	for(iter = _forces.begin(); iter != _forces.end(); ++iter) {
+		if(*iter == force) {
+			delete force;
+			_forces.erase(iter);
+			return;
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void ofxParticleMotion::clearForces() {
+	for(unsigned int i = 0; i < _forces.size(); ++i) {
+		delete _forces[i];
+	}
+	_forces.clear();
+}
+
+//--------------------------------------------------------------
+void ofxParticleMotion::update(float dt) {
+	if(dt <= 0 || x.empty()) {
+		return;
+	}
+
+	for(unsigned int i = 0; i < _forces.size(); ++i) {
+		if(_forces[i]->isEnabled()) {
+			_forces[i]->prepare(dt);
+		}
+	}
+
+	// pending particles haven't been placed yet, start them where they are
+	for(unsigned int i = 0; i < _pending.size(); ++i) {
+		if(_pending[i]) {
+			_start(i, x[i], y[i]);
+		}
+	}
+
+	int numChunks = (x.size() + _chunkSize - 1) / _chunkSize;
+	#ifdef _OPENMP
+		#pragma omp parallel for schedule(static) if(numChunks > 1)
+	#endif
+	for(int c = 0; c < numChunks; ++c) {
+		unsigned int begin = c * _chunkSize;
+		_updateChunk(begin, std::min(begin + _chunkSize, (unsigned int) x.size()), dt);
+	}
+	_lastDt = dt;
+}
+
+//--------------------------------------------------------------
+void ofxParticleMotion::setIntegrator(Integrator integrator) {
+	if(integrator == VERLET && _integrator != VERLET) {
+		// verlet keeps velocity as the last step, derive it from the velocities
+		for(unsigned int i = 0; i < x.size(); ++i) {
+			prevX[i] = x[i] - vx[i] * _lastDt;
+			prevY[i] = y[i] - vy[i] * _lastDt;
+		}
+	}
+	_integrator = integrator;
+}
+
+//--------------------------------------------------------------
+void ofxParticleMotion::save(ofxParticleSnapshot& snapshot) {
+	unsigned int num = x.size();
+	snapshot.write(num);
+	snapshot.write(_lastDt);
+	if(num > 0) {
+		snapshot.writeBytes(&x[0], num * sizeof(float));
+		snapshot.writeBytes(&y[0], num * sizeof(float));
+		snapshot.writeBytes(&vx[0], num * sizeof(float));
+		snapshot.writeBytes(&vy[0], num * sizeof(float));
+		snapshot.writeBytes(&prevX[0], num * sizeof(float));
+		snapshot.writeBytes(&prevY[0], num * sizeof(float));
+		snapshot.writeBytes(&_pending[0], num);
+	}
+}
+
+//--------------------------------------------------------------
+bool ofxParticleMotion::load(ofxParticleSnapshot& snapshot) {
+	unsigned int num = 0;
+	if(!snapshot.read(num) || !snapshot.read(_lastDt)) {
+		return false;
+	}
+	// positions, velocities, previous positions, & a pending flag each
+	if(!snapshot.canRead(num, 6 * sizeof(float) + 1)) {
+		return false;
+	}
+	resize(num);
+	if(num > 0) {
+		snapshot.readBytes(&x[0], num * sizeof(float));
+		snapshot.readBytes(&y[0], num * sizeof(float));
+		snapshot.readBytes(&vx[0], num * sizeof(float));
+		snapshot.readBytes(&vy[0], num * sizeof(float));
+		snapshot.readBytes(&prevX[0], num * sizeof(float));
+		snapshot.readBytes(&prevY[0], num * sizeof(float));
+		snapshot.readBytes(&_pending[0], num);
+	}
+	return snapshot.isGood();
+}
+
+/* ***** PRIVATE ***** */
+
+//--------------------------------------------------------------
+void ofxParticleMotion::_start(unsigned int index, float px, float py) {
+	x[index] = px;
+	y[index] = py;
+	prevX[index] = px - vx[index] * _lastDt;
+	prevY[index] = py - vy[index] * _lastDt;
+	_pending[index] = false;
+}
+
+//--------------------------------------------------------------
+void ofxParticleMotion::_updateChunk(unsigned int begin, unsigned int end, float dt) {
+	memset(&ax[begin], 0, (end - begin) * sizeof(float));
+	memset(&ay[begin], 0, (end - begin) * sizeof(float));
+	for(unsigned int i = 0; i < _forces.size(); ++i) {
+		if(_forces[i]->isEnabled()) {
+			_forces[i]->apply(*this, begin, end);
+		}
+	}
+	switch(_integrator) {
+		case EULER:
+			_euler(begin, end, dt);
+			break;
+		case SEMI_IMPLICIT:
+			_semiImplicit(begin, end, dt);
+			break;
+		case VERLET:
+			_verlet(begin, end, dt);
+			break;
+	}
+}
+
+//--------------------------------------------------------------
+void ofxParticleMotion::_euler(unsigned int begin, unsigned int end, float dt) {
+	unsigned int i = begin;
+	#ifdef __SSE__
+		__m128 t = _mm_set1_ps(dt);
+		for(; i+4 <= end; i += 4) {
+			__m128 vx4 = _mm_loadu_ps(&vx[i]), vy4 = _mm_loadu_ps(&vy[i]);
+			_mm_storeu_ps(&x[i], _mm_add_ps(_mm_loadu_ps(&x[i]), _mm_mul_ps(vx4, t)));
+			_mm_storeu_ps(&y[i], _mm_add_ps(_mm_loadu_ps(&y[i]), _mm_mul_ps(vy4, t)));
+			_mm_storeu_ps(&vx[i], _mm_add_ps(vx4, _mm_mul_ps(_mm_loadu_ps(&ax[i]), t)));
+			_mm_storeu_ps(&vy[i], _mm_add_ps(vy4, _mm_mul_ps(_mm_loadu_ps(&ay[i]), t)));
+		}
+	#endif
+	for(; i < end; ++i) {
+		x[i] += vx[i] * dt;
+		y[i] += vy[i] * dt;
+		vx[i] += ax[i] * dt;
+		vy[i] += ay[i] * dt;
+	}
+}
+
+//--------------------------------------------------------------
+void ofxParticleMotion::_semiImplicit(unsigned int begin, unsigned int end, float dt) {
+	unsigned int i = begin;
+	#ifdef __SSE__
+		__m128 t = _mm_set1_ps(dt);
+		for(; i+4 <= end; i += 4) {
+			__m128 vx4 = _mm_add_ps(_mm_loadu_ps(&vx[i]), _mm_mul_ps(_mm_loadu_ps(&ax[i]), t));
+			__m128 vy4 = _mm_add_ps(_mm_loadu_ps(&vy[i]), _mm_mul_ps(_mm_loadu_ps(&ay[i]), t));
+			_mm_storeu_ps(&vx[i], vx4);
+			_mm_storeu_ps(&vy[i], vy4);
+			_mm_storeu_ps(&x[i], _mm_add_ps(_mm_loadu_ps(&x[i]), _mm_mul_ps(vx4, t)));
+			_mm_storeu_ps(&y[i], _mm_add_ps(_mm_loadu_ps(&y[i]), _mm_mul_ps(vy4, t)));
+		}
+	#endif
+	for(; i < end; ++i) {
+		vx[i] += ax[i] * dt;
+		vy[i] += ay[i] * dt;
+		x[i] += vx[i] * dt;
+		y[i] += vy[i] * dt;
+	}
+}
+
+//--------------------------------------------------------------
+void ofxParticleMotion::_verlet(unsigned int begin, unsigned int end, float dt) {
+	// x' = x + (x - prev) * dt/lastDt + a * dt², time corrected for
+	// changing frame times, velocity is the last step
+	float ratio = dt / _lastDt, dt2 = dt * dt, invDt = 1 / dt;
+	unsigned int i = begin;
+	#ifdef __SSE__
+		__m128 r = _mm_set1_ps(ratio), t2 = _mm_set1_ps(dt2), it = _mm_set1_ps(invDt);
+		for(; i+4 <= end; i += 4) {
+			__m128 x4 = _mm_loadu_ps(&x[i]), y4 = _mm_loadu_ps(&y[i]);
+			__m128 nx = _mm_add_ps(x4, _mm_add_ps(
+				_mm_mul_ps(_mm_sub_ps(x4, _mm_loadu_ps(&prevX[i])), r),
+				_mm_mul_ps(_mm_loadu_ps(&ax[i]), t2)));
+			__m128 ny = _mm_add_ps(y4, _mm_add_ps(
+				_mm_mul_ps(_mm_sub_ps(y4, _mm_loadu_ps(&prevY[i])), r),
+				_mm_mul_ps(_mm_loadu_ps(&ay[i]), t2)));
+			_mm_storeu_ps(&prevX[i], x4);
+			_mm_storeu_ps(&prevY[i], y4);
+			_mm_storeu_ps(&x[i], nx);
+			_mm_storeu_ps(&y[i], ny);
+			_mm_storeu_ps(&vx[i], _mm_mul_ps(_mm_sub_ps(nx, x4), it));
+			_mm_storeu_ps(&vy[i], _mm_mul_ps(_mm_sub_ps(ny, y4), it));
+		}
+	#endif
+	for(; i < end; ++i) {
+		float nx = x[i] + (x[i] - prevX[i]) * ratio + ax[i] * dt2;
+		float ny = y[i] + (y[i] - prevY[i]) * ratio + ay[i] * dt2;
+		prevX[i] = x[i];
+		prevY[i] = y[i];
+		vx[i] = (nx - x[i]) * invDt;
+		vy[i] = (ny - y[i]) * invDt;
+		x[i] = nx;
+		y[i] = ny;
+	}
+}
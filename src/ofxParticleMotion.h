@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+#include "ofxParticleForces.h"
+#include "ofxParticleSnapshot.h"
+
+/**
+	\class  ParticleMotion
+	\brief  moves particles with a stack of force fields
+
+	positions, velocities, & accelerations are stored as separate contiguous
+	arrays (structure of arrays) so the forces & the integrator can process
+	4 particles at a time with SSE, when available, & split the particles into
+	chunks across threads with OpenMP, when enabled
+
+	an ofxParticleManagerT keeps one in sync with its particle list, see
+	ofxParticleManagerT::setMotionEnabled(), or use one directly:
+
+	    motion.addForce(new ofxParticleUniformForce(0, 98)); // gravity
+	    motion.addForce(new ofxParticleDrag(0.5));
+	    motion.add(x, y, vx, vy);
+	    ...
+	    motion.update(ofGetLastFrameTime());
+**/
+class ofxParticleMotion {
+	public:
+
+		/// integration methods
+		enum Integrator {
+			EULER,         ///< explicit euler, cheapest, least stable
+			SEMI_IMPLICIT, ///< symplectic euler, velocity first (default)
+			VERLET         ///< position verlet, good for constraints & springs
+		};
+
+		ofxParticleMotion();
+		virtual ~ofxParticleMotion();
+
+	/// \section Particles
+
+		/// add a particle, returns its index
+		unsigned int add(float x, float y, float vx=0, float vy=0);
+
+		/// add a particle whose position is set on the next gather, used by
+		/// ofxParticleManagerT, returns its index
+		unsigned int addPending(float vx=0, float vy=0);
+
+		/// remove the particle at an index, keeps the order
+		void remove(unsigned int index);
+
+		/// copy the particle at one index to another, used for compacting
+		void move(unsigned int from, unsigned int to);
+
+		/// resize to a number of particles, new particles are pending
+		void resize(unsigned int size);
+
+		/// remove all particles
+		void clear();
+
+		/// set a particle's position or velocity
+		void setPosition(unsigned int index, float x, float y);
+		void setVelocity(unsigned int index, float vx, float vy);
+
+		/// number of particles
+		unsigned int size() {return x.size();}
+
+	/// \section Forces
+
+		/// add a force, takes ownership
+		void addForce(ofxParticleForce* force);
+
+		/// remove (delete) a force
+		void removeForce(ofxParticleForce* force);
+
+		/// remove (delete) all forces
+		void clearForces();
+
+		unsigned int getNumForces() {return _forces.size();}
+
+	/// \section Update
+
+		/// apply the forces & integrate by a time step in seconds
+		void update(float dt);
+
+		/// gather the positions from a particle list with x & y members,
+		/// pending particles are initialized from them
+		template <class P>
+		void gather(std::vector<P>& particles) {
+			unsigned int num = std::min(particles.size(), x.size());
+			for(unsigned int i = 0; i < num; ++i) {
+				if(_pending[i]) {
+					_start(i, particles[i].x, particles[i].y);
+				}
+				else {
+					x[i] = particles[i].x;
+					y[i] = particles[i].y;
+				}
+			}
+		}
+
+		/// write the positions back to a particle list with x & y members
+		template <class P>
+		void scatter(std::vector<P>& particles) {
+			unsigned int num = std::min(particles.size(), x.size());
+			for(unsigned int i = 0; i < num; ++i) {
+				particles[i].x = x[i];
+				particles[i].y = y[i];
+			}
+		}
+
+	/// \section Snapshot
+
+		/// write & read the particle motion state, the forces are not saved
+		void save(ofxParticleSnapshot& snapshot);
+		bool load(ofxParticleSnapshot& snapshot);
+
+	/// \section Settings
+
+		inline Integrator getIntegrator()    {return _integrator;}
+		void setIntegrator(Integrator integrator);
+
+		/// number of particles per chunk when threaded (default 1024)
+		inline unsigned int getChunkSize()   {return _chunkSize;}
+		void setChunkSize(unsigned int size) {_chunkSize = size < 4 ? 4 : size;}
+
+	/// \section Data
+
+		/// particle arrays, indexed the same, prevX & prevY are the last
+		/// positions for verlet integration
+		std::vector<float> x, y;
+		std::vector<float> vx, vy;
+		std::vector<float> ax, ay;
+		std::vector<float> prevX, prevY;
+
+	private:
+
+		/// set the start position of a particle
+		void _start(unsigned int index, float px, float py);
+
+		/// process the particles from begin up to end
+		void _updateChunk(unsigned int begin, unsigned int end, float dt);
+
+		/// integrators
+		void _euler(unsigned int begin, unsigned int end, float dt);
+		void _semiImplicit(unsigned int begin, unsigned int end, float dt);
+		void _verlet(unsigned int begin, unsigned int end, float dt);
+
+		std::vector<ofxParticleForce*> _forces; ///< owned forces
+		std::vector<unsigned char> _pending;    ///< waiting for a position?
+		Integrator _integrator;  ///< integration method
+		unsigned int _chunkSize; ///< particles per chunk
+		float _lastDt;           ///< last time step, for starting verlet
+};
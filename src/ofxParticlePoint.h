@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#pragma once
+
+#include "ofAppRunner.h"
+#include "ofGraphics.h"
+#include "ofRectangle.h"
+#include "ofTypes.h"
+
+#include "ofxParticle.h"
+
+/**
+	\class  ParticlePoint
+	\brief  a compact point particle with a lifespan
+
+	ofxParticle carries an ofRectangle, a vtable, & its own timer, this is a
+	24 byte plain struct for large numbers of simple particles stored by value
+	in an ofxParticleManagerT:
+
+	    ofxParticleManagerT<ofxParticlePoint> points;
+	    points.addParticle(ofxParticlePoint(x, y, 4, 2000));
+
+	there is no per particle timer, ages are advanced by the frame clock
+	(the last frame time) which ignores frames longer than
+	ofxParticle::getFrameTimeout() just like ofxParticle
+
+	x & y are the center of the point, extend it by wrapping it in your own
+	struct or inheriting & hiding update()/draw(), there are no virtuals
+**/
+struct ofxParticlePoint {
+
+	/// packed state flags, bits from USER on are free for your own use
+	enum Flags {
+		ALIVE = 0x01, ///< is this particle alive?
+		USER  = 0x02  ///< first user flag bit
+	};
+
+	float x, y;          ///< center position
+	float size;          ///< diameter
+	float age;           ///< how old the particle is in ms
+	float lifespan;      ///< how long this particle should live in ms
+	unsigned char flags; ///< packed state flags
+
+	ofxParticlePoint() :
+		x(0), y(0), size(0), age(0), lifespan(0), flags(ALIVE) {}
+	ofxParticlePoint(float x, float y, float size, float lifespan) :
+		x(x), y(y), size(size), age(0), lifespan(lifespan), flags(ALIVE) {}
+
+	/// \section Main
+
+	/// update the age by the frame clock
+	inline void updateAge() {updateAge(getFrameTime());}
+
+	/// update the age by a time in ms
+	inline void updateAge(float ms) {
+		if(!isAlive())
+			return;
+		age += ms;
+		if(age >= lifespan)
+			kill();
+	}
+
+	/// default update & draw, hide these in your own particle type
+	inline void update() {updateAge();}
+	inline void draw()   {ofRect(x - size/2, y - size/2, size, size);}
+
+	/// fill the attributes used for batched drawing
+	inline void fillInstance(ofxParticleInstance& instance) const {
+		instance.x = x - size/2;
+		instance.y = y - size/2;
+		instance.width = instance.height = size;
+		instance.r = instance.g = instance.b = instance.a = 1;
+		instance.age = getAgeN();
+	}
+
+	/// \section Status
+
+	/// bring this particle to life
+	inline void reset() {flags |= ALIVE; age = 0;}
+
+	/// get the age normalized between 0 and 1: 0 is birth, 1 is death
+	inline float getAgeN() const {return lifespan == 0 ? 0 : age/lifespan;}
+
+	/// get the remaining life in ms
+	inline float getRemainingLife() const {return lifespan - age;}
+
+	/// is this particle alive?
+	inline bool isAlive() const {return flags & ALIVE;}
+
+	/// kill the particle
+	inline void kill() {flags &= ~ALIVE; age = 0;}
+
+	/// user flag access
+	inline bool getFlag(unsigned char flag) const {return flags & flag;}
+	inline void setFlag(unsigned char flag, bool yesno) {
+		if(yesno) flags |= flag;
+		else      flags &= ~flag;
+	}
+
+	/// \section Snapshot
+
+	/// write & read the particle state, used by ofxParticleManagerT
+	void save(ofxParticleSnapshot& snapshot) const {
+		snapshot.write(x);
+		snapshot.write(y);
+		snapshot.write(size);
+		snapshot.write(age);
+		snapshot.write(lifespan);
+		snapshot.write(flags);
+	}
+	bool load(ofxParticleSnapshot& snapshot) {
+		return snapshot.read(x) && snapshot.read(y) && snapshot.read(size) &&
+		       snapshot.read(age) && snapshot.read(lifespan) && snapshot.read(flags);
+	}
+
+	/// \section Util
+
+	/// the bounding rect, used by ofxParticleGrid
+	operator ofRectangle() const {
+		return ofRectangle(x - size/2, y - size/2, size, size);
+	}
+
+	/// the frame clock: the last frame time in ms, 0 if the frame took longer
+	/// than ofxParticle::getFrameTimeout()
+	static inline float getFrameTime() {
+		float ms = ofGetLastFrameTime() * 1000.0;
+		return ms < ofxParticle::getFrameTimeout() ? ms : 0;
+	}
+};
+
+/**
+	\class  ParticleAdapter
+	\brief  lets existing ofxParticle subclasses live in an ofxParticleManagerT
+
+	ofxParticle is abstract so its subclasses can't be mixed in a by value
+	manager, the adapter owns a particle through a shared pointer & forwards
+	to it:
+
+	    ofxParticleManagerT<ofxParticleAdapter> particles;
+	    particles.addParticle(new MyParticle(x, y, 10, 10));
+
+	the particle is deleted when the last adapter copy is removed, this keeps
+	the old virtual calls so switch hot particle types to a compact struct
+	when you can
+
+	note: the by value manager doesn't set ids or random frames on wrapped
+	      particles, use the manager's getRandom() with the particle index
+	      instead of ofxParticle::getRandom()
+**/
+class ofxParticleAdapter {
+	public:
+
+		/// takes ownership of the particle
+		ofxParticleAdapter(ofxParticle* particle) : particle(particle) {}
+
+		inline void update()  {particle->update();}
+		inline void draw()    {particle->draw();}
+		inline bool isAlive() {return particle->isAlive();}
+
+		inline void fillInstance(ofxParticleInstance& instance) {
+			particle->fillInstance(instance);
+		}
+
+		/// the bounding rect, used by ofxParticleGrid
+		operator ofRectangle() const {return *particle;}
+
+		/// the wrapped particle
+		inline ofxParticle* get()        {return particle.get();}
+		inline ofxParticle* operator->() {return particle.get();}
+
+	protected:
+
+		ofPtr<ofxParticle> particle; ///< shared wrapped particle
+};
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#pragma once
+
+#include <vector>
+
+/**
+	\class  ParticleRandom
+	\brief  a counter based random number stream
+
+	ofRandom() wraps the global rand(), which isn't thread safe & depends on
+	everything else that called it, this stream is a pure function of a seed,
+	a stream id (ie a particle id), a frame number, & a counter:
+
+	    ofxParticleRandom random(seed, particleId, frame);
+	    float angle = random.next(0, TWO_PI);
+	    float speed = random.next(1, 5);
+
+	the same seed, id, & frame always give the same numbers no matter which
+	thread makes the stream or in what order, so parallel updates match a
+	serial run & a whole run can be replayed from the seed
+
+	the stream key is mixed from the seed, id, & frame with the SplitMix64
+	finalizer & each number is a 32 bit hash of the key & counter, good
+	enough for visuals, not for cryptography
+**/
+class ofxParticleRandom {
+	public:
+
+		ofxParticleRandom(unsigned long long seed=0, unsigned int id=0, unsigned int frame=0) :
+			_seed(seed) {
+			setStream(id, frame);
+		}
+
+	/// \section Stream
+
+		/// start a new stream for an id & frame, resets the counter
+		void setStream(unsigned int id, unsigned int frame) {
+			_key = makeKey(_seed, id, frame);
+			_counter = 0;
+		}
+
+		/// set the seed, starts stream 0, 0
+		void setSeed(unsigned long long seed) {
+			_seed = seed;
+			setStream(0, 0);
+		}
+		inline unsigned long long getSeed() {return _seed;}
+
+		/// the counter, the number of values drawn from this stream
+		inline unsigned int getCounter()      {return _counter;}
+		void setCounter(unsigned int counter) {_counter = counter;}
+
+	/// \section Numbers
+
+		/// a random 32 bit int
+		inline unsigned int nextInt() {return hash(_key, _counter++);}
+
+		/// a random float in [0, 1)
+		inline float next() {return toFloat(nextInt());}
+
+		/// a random float in [0, max) or [min, max), like ofRandom()
+		inline float next(float max)            {return next() * max;}
+		inline float next(float min, float max) {return min + next() * (max - min);}
+
+		/// a random float in [-1, 1)
+		inline float nextSigned() {return next() * 2 - 1;}
+
+		/// fill an array with random floats in [min, max), uses count values
+		/// from the stream, the loop has no dependencies between values so
+		/// the compiler can vectorize it
+		void fill(float* values, unsigned int count, float min=0, float max=1) {
+			unsigned int key = _key, counter = _counter;
+			float range = max - min;
+			for(unsigned int i = 0; i < count; ++i) {
+				values[i] = min + toFloat(hash(key, counter + i)) * range;
+			}
+			_counter += count;
+		}
+		void fill(std::vector<float>& values, unsigned int count, float min=0, float max=1) {
+			values.resize(count);
+			if(count > 0) {
+				fill(&values[0], count, min, max);
+			}
+		}
+
+	/// \section Util
+
+		/// mix a seed, id, & frame into a stream key with the SplitMix64
+		/// finalizer
+		static inline unsigned int makeKey(unsigned long long seed, unsigned int id, unsigned int frame) {
+			unsigned long long z = seed + 0x9E3779B97F4A7C15ULL * (((unsigned long long) id << 32 | frame) + 1);
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+			z ^= z >> 31;
+			return (unsigned int) (z ^ (z >> 32));
+		}
+
+		/// hash a stream key & counter into a random 32 bit int, a weyl
+		/// sequence through an integer finalizer
+		static inline unsigned int hash(unsigned int key, unsigned int counter) {
+			unsigned int x = key + counter * 0x9E3779B9U;
+			x ^= x >> 16;
+			x *= 0x7FEB352DU;
+			x ^= x >> 15;
+			x *= 0x846CA68BU;
+			x ^= x >> 16;
+			return x;
+		}
+
+		/// convert the top 24 bits of an int to a float in [0, 1)
+		static inline float toFloat(unsigned int x) {
+			return (x >> 8) * (1.0f / 16777216.0f);
+		}
+
+	private:
+
+		unsigned long long _seed; ///< run seed
+		unsigned int _key;        ///< stream key
+		unsigned int _counter;    ///< next value in the stream
+};
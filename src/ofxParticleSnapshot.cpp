@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#include "ofxParticleSnapshot.h"
+
+#include "ofFileUtils.h"
+#include "ofLog.h"
+
+// file header
+static const char SNAPSHOT_MAGIC[4] = {'O', 'F', 'X', 'P'};
+static const unsigned int SNAPSHOT_VERSION = 1;
+
+/// PARTICLE SNAPSHOT
+
+//--------------------------------------------------------------
+ofxParticleSnapshot::ofxParticleSnapshot() : _readPos(0), _bGood(true) {}
+
+//--------------------------------------------------------------
+void ofxParticleSnapshot::clear() {
+	_data.clear();
+	rewind();
+}
+
+//--------------------------------------------------------------
+void ofxParticleSnapshot::writeBytes(const void* bytes, unsigned int size) {
+	const char* b = (const char*) bytes;
+	_data.insert(_data.end(), b, b + size);
+}
+
+//--------------------------------------------------------------
+unsigned int ofxParticleSnapshot::beginRecord(unsigned int type) {
+	write(type);
+	unsigned int pos = _data.size();
+	write((unsigned int) 0); // size, set by endRecord()
+	return pos;
+}
+
+//--------------------------------------------------------------
+void ofxParticleSnapshot::endRecord(unsigned int pos) {
+	if(pos + sizeof(unsigned int) > _data.size()) {
+		ofLogWarning("ofxParticleSnapshot") << "bad record position " << pos;
+		return;
+	}
+	unsigned int size = _data.size() - pos - sizeof(unsigned int);
+	memcpy(&_data[pos], &size, sizeof(size));
+}
+
+//--------------------------------------------------------------
+bool ofxParticleSnapshot::readBytes(void* bytes, unsigned int size) {
+	if(!_bGood || size > getRemaining()) {
+		_bGood = false;
+		return false;
+	}
+	if(size > 0) {
+		memcpy(bytes, &_data[_readPos], size);
+	}
+	_readPos += size;
+	return true;
+}
+
+//--------------------------------------------------------------
+bool ofxParticleSnapshot::readRecord(unsigned int& type, unsigned int& size) {
+	return read(type) && read(size);
+}
+
+//--------------------------------------------------------------
+bool ofxParticleSnapshot::skip(unsigned int size) {
+	if(!_bGood || size > getRemaining()) {
+		_bGood = false;
+		return false;
+	}
+	_readPos += size;
+	return true;
+}
+
+//--------------------------------------------------------------
+bool ofxParticleSnapshot::canRead(unsigned int count, unsigned int size) {
+	if(!_bGood || (size > 0 && count > getRemaining() / size)) {
+		_bGood = false;
+		return false;
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+void ofxParticleSnapshot::rewind() {
+	_readPos = 0;
+	_bGood = true;
+}
+
+//--------------------------------------------------------------
+bool ofxParticleSnapshot::save(const std::string& path) {
+	ofBuffer buffer;
+	buffer.append(SNAPSHOT_MAGIC, 4);
+	buffer.append((const char*) &SNAPSHOT_VERSION, sizeof(SNAPSHOT_VERSION));
+	if(!_data.empty()) {
+		buffer.append(&_data[0], _data.size());
+	}
+	if(!ofBufferToFile(path, buffer, true)) {
+		ofLogError("ofxParticleSnapshot") << "couldn't write \"" << path << "\"";
+		return false;
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+bool ofxParticleSnapshot::load(const std::string& path) {
+	ofBuffer buffer = ofBufferFromFile(path, true);
+	const char* bytes = buffer.getBinaryBuffer();
+	unsigned int header = 4 + sizeof(SNAPSHOT_VERSION), version = 0;
+	if(buffer.size() >= header) {
+		memcpy(&version, bytes + 4, sizeof(version));
+	}
+	if(buffer.size() < header || memcmp(bytes, SNAPSHOT_MAGIC, 4) != 0 ||
+	   version != SNAPSHOT_VERSION) {
+		ofLogError("ofxParticleSnapshot") << "\"" << path << "\" is not a valid particle snapshot";
+		return false;
+	}
+	_data.assign(bytes + header, bytes + buffer.size());
+	rewind();
+	return true;
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstring>
+
+/**
+	\class  ParticleSnapshot
+	\brief  a flat binary blob of particle system state
+
+	the particle managers write their whole state into a snapshot & restore
+	it later, ie pre-simulate a particle system while loading & restore it
+	instantly when a scene enters:
+
+	    manager.update(); // x hundreds of frames
+	    manager.saveSnapshot(warmup);
+	    ...
+	    manager.loadSnapshot(warmup);
+
+	values are written in native byte order & snapshots are meant for the
+	machine that wrote them, save() & load() keep a snapshot in a file
+
+	particles & emitters add their own state by overriding their save() &
+	load() & using write() & read(), reads return false when the data runs
+	out & the snapshot stays failed until rewind()
+**/
+class ofxParticleSnapshot {
+	public:
+
+		ofxParticleSnapshot();
+
+		/// discard all data
+		void clear();
+
+	/// \section Writing
+
+		/// append a plain value
+		template <class T>
+		void write(const T& value) {
+			writeBytes(&value, sizeof(T));
+		}
+
+		/// append raw bytes
+		void writeBytes(const void* bytes, unsigned int size);
+
+		/// start a record of a type, returns the record position for
+		/// endRecord(), records store their size so unknown types can be
+		/// skipped when reading
+		unsigned int beginRecord(unsigned int type);
+
+		/// set the size of the record started at a position
+		void endRecord(unsigned int pos);
+
+	/// \section Reading
+
+		/// read a plain value, returns false if there is no more data
+		template <class T>
+		bool read(T& value) {
+			return readBytes(&value, sizeof(T));
+		}
+
+		/// read raw bytes, returns false if there is no more data
+		bool readBytes(void* bytes, unsigned int size);
+
+		/// read a record header, returns false if there is no more data
+		bool readRecord(unsigned int& type, unsigned int& size);
+
+		/// skip bytes, ie the rest of an unknown record
+		bool skip(unsigned int size);
+
+		/// can a number of values of at least a size still be read? fails
+		/// the snapshot if not, check counts read from the data before
+		/// allocating for them so a corrupt count can't allocate too much
+		bool canRead(unsigned int count, unsigned int size);
+
+		/// go back to the start & clear any read failure
+		void rewind();
+
+		/// the read position
+		inline unsigned int tell() {return _readPos;}
+
+		/// false after a read ran out of data
+		inline bool isGood() {return _bGood;}
+
+		/// are there bytes left to read?
+		inline bool isEnd() {return _readPos >= _data.size();}
+
+		/// the number of bytes left to read
+		inline unsigned int getRemaining() {
+			return _readPos < _data.size() ? _data.size() - _readPos : 0;
+		}
+
+	/// \section Data
+
+		/// the snapshot bytes
+		inline const std::vector<char>& getData() {return _data;}
+		inline unsigned int size() {return _data.size();}
+		inline bool empty() {return _data.empty();}
+
+		/// write the snapshot to a file, returns false on error
+		bool save(const std::string& path);
+
+		/// read a snapshot from a file, returns false on error
+		bool load(const std::string& path);
+
+	private:
+
+		std::vector<char> _data; ///< snapshot bytes
+		unsigned int _readPos;   ///< read position
+		bool _bGood;             ///< no failed reads?
+};
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#include "ofxParticleSorter.h"
+
+#include <cstring>
+
+// insertion sort shifts allowed per key before falling back to a radix sort,
+// a radix sort costs about 8 passes over the keys
+#define MAX_SHIFTS_PER_KEY 2
+
+/// PARTICLE SORTER
+
+//--------------------------------------------------------------
+ofxParticleSorter::ofxParticleSorter() :
+	_bIncremental(true), _bWasIncremental(false) {}
+
+//--------------------------------------------------------------
+void ofxParticleSorter::sort(const std::vector<float>& keys) {
+	_bWasIncremental = false;
+	if(keys.empty()) {
+		_order.clear();
+		return;
+	}
+	if(_bIncremental && !_order.empty() && _insertionSort(keys)) {
+		_bWasIncremental = true;
+		return;
+	}
+	_radixSort(keys);
+}
+
+//--------------------------------------------------------------
+void ofxParticleSorter::clear() {
+	_order.clear();
+}
+
+/* ***** PRIVATE ***** */
+
+//--------------------------------------------------------------
+bool ofxParticleSorter::_insertionSort(const std::vector<float>& keys) {
+	unsigned int num = keys.size();
+
+	// start from the last order, dropping indices past the end & appending
+	// new ones, the keys may belong to different particles now but any
+	// permutation is a valid starting point
+	unsigned int last = _order.size(), write = 0;
+	for(unsigned int i = 0; i < last; ++i) {
+		if(_order[i] < num) {
+			_order[write++] = _order[i];
+		}
+	}
+	_order.resize(write);
+	for(unsigned int i = last; i < num; ++i) {
+		_order.push_back(i);
+	}
+
+	unsigned int maxShifts = num * MAX_SHIFTS_PER_KEY, shifts = 0;
+	unsigned int* order = &_order[0];
+	for(unsigned int i = 1; i < num; ++i) {
+		unsigned int index = order[i];
+		float key = keys[index];
+		unsigned int j = i;
+		while(j > 0 && keys[order[j-1]] > key) {
+			order[j] = order[j-1];
+			--j;
+		}
+		order[j] = index;
+		shifts += i - j;
+		if(shifts > maxShifts) {
+			return false;
+		}
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+void ofxParticleSorter::_radixSort(const std::vector<float>& keys) {
+	unsigned int num = keys.size();
+	_order.resize(num);
+	_temp.resize(num);
+	_bits.resize(num);
+	_tempBits.resize(num);
+
+	// flip the float bits so they sort as unsigned ints: negative numbers
+	// have all bits flipped, positive numbers only the sign bit
+	for(unsigned int i = 0; i < num; ++i) {
+		unsigned int bits;
+		memcpy(&bits, &keys[i], sizeof(bits));
+		_bits[i] = bits ^ ((bits & 0x80000000) ? 0xFFFFFFFF : 0x80000000);
+		_order[i] = i;
+	}
+
+	unsigned int counts[256];
+	for(unsigned int shift = 0; shift < 32; shift += 8) {
+		memset(counts, 0, sizeof(counts));
+		for(unsigned int i = 0; i < num; ++i) {
+			counts[(_bits[i] >> shift) & 0xFF]++;
+		}
+		if(counts[(_bits[0] >> shift) & 0xFF] == num) {
+			continue; // all keys share this byte
+		}
+
+		// counts to start offsets
+		unsigned int offset = 0;
+		for(unsigned int b = 0; b < 256; ++b) {
+			unsigned int count = counts[b];
+			counts[b] = offset;
+			offset += count;
+		}
+
+		// scatter in order, keeps equal bytes stable
+		for(unsigned int i = 0; i < num; ++i) {
+			unsigned int dest = counts[(_bits[i] >> shift) & 0xFF]++;
+			_temp[dest] = _order[i];
+			_tempBits[dest] = _bits[i];
+		}
+		_order.swap(_temp);
+		_bits.swap(_tempBits);
+	}
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#pragma once
+
+#include <vector>
+
+/**
+	\class  ParticleSorter
+	\brief  sorts particle indices by a float key, lowest key first
+
+	used by ofxParticleManager to set the draw order, sort() fills an index
+	array instead of moving the particles:
+
+	    sorter.sort(keys);
+	    for(unsigned int i = 0; i < sorter.size(); ++i) {
+	        particles[sorter[i]]->draw();
+	    }
+
+	a full sort is a stable LSD radix sort over the key bits, 4 passes of 8
+	bits with passes skipped when all keys share the same byte
+
+	when incremental, the last order is reused as the starting point &
+	fixed up with an insertion sort, which is close to linear when the keys
+	barely change between frames, the insertion sort gives up & falls back to
+	a full sort when the keys changed too much, equal keys keep their last
+	order in this case
+**/
+class ofxParticleSorter {
+	public:
+
+		ofxParticleSorter();
+
+		/// sort indices 0 to keys.size()-1 by key
+		void sort(const std::vector<float>& keys);
+
+		/// sorted indices from the last sort
+		inline const std::vector<unsigned int>& getOrder() {return _order;}
+		inline unsigned int operator[](unsigned int i) {return _order[i];}
+		inline unsigned int size() {return _order.size();}
+
+		/// forget the last order, the next sort is a full sort
+		void clear();
+
+	/// \section Settings
+
+		/// reuse the last order when possible? (default true)
+		inline bool getIncremental()   {return _bIncremental;}
+		void setIncremental(bool yesno) {_bIncremental = yesno;}
+
+		/// was the last sort done incrementally?
+		inline bool wasIncremental()   {return _bWasIncremental;}
+
+	private:
+
+		/// fix up the last order with an insertion sort, returns false if
+		/// too many keys moved
+		bool _insertionSort(const std::vector<float>& keys);
+
+		/// stable radix sort
+		void _radixSort(const std::vector<float>& keys);
+
+		std::vector<unsigned int> _order;   ///< sorted indices
+		std::vector<unsigned int> _temp;    ///< radix scratch indices
+		std::vector<unsigned int> _bits;    ///< radix keys as sortable bits
+		std::vector<unsigned int> _tempBits; ///< radix scratch keys
+		bool _bIncremental;    ///< reuse the last order?
+		bool _bWasIncremental; ///< was the last sort incremental?
+};
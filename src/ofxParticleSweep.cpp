@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#include "ofxParticleSweep.h"
+
+#include <algorithm>
+
+/// PARTICLE SWEEP
+
+//--------------------------------------------------------------
+ofxParticleSweep::ofxParticleSweep() :
+	_numItems(0), _numNew(0), _bRemoved(false), _numMoves(0), _stamp(0) {}
+
+//--------------------------------------------------------------
+void ofxParticleSweep::update(unsigned int index, const ofRectangle& rect) {
+	if(index >= _items.size()) {
+		Item empty = {0, 0, 0, 0, false, 0};
+		_items.resize(index+1, empty);
+	}
+	// normalize so the min endpoint never sorts after the max, a negative
+	// size would close the item in the sweep before it was opened
+	Item& item = _items[index];
+	item.minX = std::min(rect.x, rect.x + rect.width);
+	item.maxX = std::max(rect.x, rect.x + rect.width);
+	item.minY = std::min(rect.y, rect.y + rect.height);
+	item.maxY = std::max(rect.y, rect.y + rect.height);
+	if(!item.bUsed) {
+		item.bUsed = true;
+		item.stamp = ++_stamp;
+		Endpoint e = {item.minX, index, item.stamp, true};
+		_endpoints.push_back(e);
+		e.value = item.maxX;
+		e.bMin = false;
+		_endpoints.push_back(e);
+		_numItems++;
+		_numNew += 2;
+	}
+}
+
+//--------------------------------------------------------------
+void ofxParticleSweep::remove(unsigned int index) {
+	if(!contains(index)) {
+		return;
+	}
+	_items[index].bUsed = false;
+	_numItems--;
+	_bRemoved = true;
+}
+
+//--------------------------------------------------------------
+void ofxParticleSweep::resize(unsigned int size) {
+	for(unsigned int i = size; i < _items.size(); ++i) {
+		remove(i);
+	}
+	if(size < _items.size()) {
+		_items.resize(size);
+	}
+}
+
+//--------------------------------------------------------------
+void ofxParticleSweep::clear() {
+	_items.clear();
+	_endpoints.clear();
+	_pairs.clear();
+	_numItems = _numNew = 0;
+	_bRemoved = false;
+}
+
+//--------------------------------------------------------------
+const std::vector<ofxParticleSweep::Pair>& ofxParticleSweep::findPairs() {
+	if(_bRemoved) {
+		_removeEndpoints();
+	}
+	_sortEndpoints();
+
+	// sweep along x, each opening item overlaps the open items on x
+	_pairs.clear();
+	_active.clear();
+	_activePos.resize(_items.size());
+	for(unsigned int i = 0; i < _endpoints.size(); ++i) {
+		const Endpoint& e = _endpoints[i];
+		if(e.bMin) {
+			const Item& item = _items[e.item];
+			for(unsigned int j = 0; j < _active.size(); ++j) {
+				const Item& other = _items[_active[j]];
+				if(item.minY <= other.maxY && other.minY <= item.maxY) {
+					if(e.item < _active[j])
+						_pairs.push_back(std::make_pair(e.item, _active[j]));
+					else
+						_pairs.push_back(std::make_pair(_active[j], e.item));
+				}
+			}
+			_activePos[e.item] = _active.size();
+			_active.push_back(e.item);
+		}
+		else {
+			// swap remove
+			unsigned int pos = _activePos[e.item];
+			_active[pos] = _active.back();
+			_activePos[_active[pos]] = pos;
+			_active.pop_back();
+		}
+	}
+
+	for(unsigned int i = 0; i < _listeners.size(); ++i) {
+		for(unsigned int j = 0; j < _pairs.size(); ++j) {
+			_listeners[i]->particlesOverlap(_pairs[j].first, _pairs[j].second);
+		}
+	}
+	return _pairs;
+}
+
+//--------------------------------------------------------------
+void ofxParticleSweep::addListener(ofxParticleOverlapListener* listener) {
+	if(listener != NULL && std::find(_listeners.begin(), _listeners.end(), listener) == _listeners.end())
+		_listeners.push_back(listener);
+}
+
+//--------------------------------------------------------------
+void ofxParticleSweep::removeListener(ofxParticleOverlapListener* listener) {
+	_listeners.erase(std::remove(_listeners.begin(), _listeners.end(), listener), _listeners.end());
+}
+
+/* ***** PRIVATE ***** */
+
+//--------------------------------------------------------------
+void ofxParticleSweep::_removeEndpoints() {
+	unsigned int write = 0;
+	for(unsigned int i = 0; i < _endpoints.size(); ++i) {
+		const Endpoint& e = _endpoints[i];
+		if(contains(e.item) && _items[e.item].stamp == e.stamp) {
+			_endpoints[write++] = _endpoints[i];
+		}
+	}
+	_endpoints.resize(write);
+	_bRemoved = false;
+}
+
+//--------------------------------------------------------------
+void ofxParticleSweep::_sortEndpoints() {
+	for(unsigned int i = 0; i < _endpoints.size(); ++i) {
+		Endpoint& e = _endpoints[i];
+		e.value = e.bMin ? _items[e.item].minX : _items[e.item].maxX;
+	}
+	_numMoves = 0;
+
+	// lots of new unsorted endpoints, start over
+	if(_numNew > _endpoints.size() / 4) {
+		std::sort(_endpoints.begin(), _endpoints.end());
+		_numNew = 0;
+		return;
+	}
+	_numNew = 0;
+
+	for(unsigned int i = 1; i < _endpoints.size(); ++i) {
+		Endpoint e = _endpoints[i];
+		unsigned int j = i;
+		while(j > 0 && e < _endpoints[j-1]) {
+			_endpoints[j] = _endpoints[j-1];
+			--j;
+		}
+		_endpoints[j] = e;
+		_numMoves += i - j;
+	}
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#pragma once
+
+#include <vector>
+#include <utility>
+
+#include "ofRectangle.h"
+
+/**
+	\class  ParticleOverlapListener
+	\brief  receives overlapping pairs from an ofxParticleSweep
+**/
+class ofxParticleOverlapListener {
+	public:
+		virtual ~ofxParticleOverlapListener() {}
+
+		/// called for each pair of overlapping items, a < b
+		virtual void particlesOverlap(unsigned int a, unsigned int b) = 0;
+};
+
+/**
+	\class  ParticleSweep
+	\brief  sort & sweep broadphase that finds overlapping rectangles
+
+	items are identified by an index like ofxParticleGrid, the min & max x
+	edges of all items are kept in a sorted endpoint list, findPairs()
+	re-sorts the list & sweeps along it keeping the items whose x ranges are
+	open, each new item is only checked against the open items on y
+
+	the list is re-sorted with an insertion sort starting from the last
+	frame's order, which is close to linear when particles move a little each
+	frame, lots of new items are sorted from scratch instead
+
+	works best when the particles are spread out more along x than y, touching
+	rects count as overlapping like ofxParticleGrid
+**/
+class ofxParticleSweep {
+	public:
+
+		/// a pair of overlapping item indices, first < second
+		typedef std::pair<unsigned int, unsigned int> Pair;
+
+		ofxParticleSweep();
+
+	/// \section Items
+
+		/// add or move an item
+		void update(unsigned int index, const ofRectangle& rect);
+
+		/// remove an item
+		void remove(unsigned int index);
+
+		/// remove all items with an index >= size, use this after updating
+		/// the items of a list that shrank
+		void resize(unsigned int size);
+
+		/// remove all items
+		void clear();
+
+		/// is there an item at this index?
+		bool contains(unsigned int index) {
+			return index < _items.size() && _items[index].bUsed;
+		}
+
+		/// number of items
+		unsigned int size() {return _numItems;}
+
+	/// \section Pairs
+
+		/// sort the endpoints & find all overlapping pairs, notifies the
+		/// listeners & returns the pair buffer
+		const std::vector<Pair>& findPairs();
+
+		/// the pairs from the last findPairs()
+		const std::vector<Pair>& getPairs() {return _pairs;}
+
+		/// add/remove an overlap listener
+		void addListener(ofxParticleOverlapListener* listener);
+		void removeListener(ofxParticleOverlapListener* listener);
+
+	/// \section Stats
+
+		/// number of endpoint moves in the last sort, high values mean the
+		/// items moved a lot
+		unsigned int getNumMoves() {return _numMoves;}
+
+	private:
+
+		/// an item's bounds
+		struct Item {
+			float minX, maxX, minY, maxY;
+			bool bUsed;
+			unsigned int stamp; ///< changes each time the item is added
+		};
+
+		/// a min or max x edge of an item
+		struct Endpoint {
+			float value;
+			unsigned int item;
+			unsigned int stamp; ///< item stamp when added
+			bool bMin;
+
+			/// mins sort before maxes at the same value so touching rects overlap
+			inline bool operator<(const Endpoint& e) const {
+				return value < e.value || (value == e.value && bMin && !e.bMin);
+			}
+		};
+
+		/// drop the endpoints of removed items
+		void _removeEndpoints();
+
+		/// sort the endpoints, insertion sort from the last order
+		void _sortEndpoints();
+
+		std::vector<Item> _items;         ///< items by index
+		std::vector<Endpoint> _endpoints; ///< sorted x edges
+		std::vector<unsigned int> _active;    ///< open items during a sweep
+		std::vector<unsigned int> _activePos; ///< item positions in _active
+		std::vector<Pair> _pairs;         ///< last found pairs
+		std::vector<ofxParticleOverlapListener*> _listeners; ///< pair listeners
+		unsigned int _numItems;    ///< number of used items
+		unsigned int _numNew;      ///< endpoints added since the last sort
+		bool _bRemoved;            ///< were items removed since the last sort?
+		unsigned int _numMoves;    ///< endpoint moves in the last sort
+		unsigned int _stamp;       ///< last item stamp
+};
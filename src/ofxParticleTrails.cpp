@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#include "ofxParticleTrails.h"
+
+#include <cmath>
+#include <algorithm>
+
+#include "ofLog.h"
+
+/// PARTICLE TRAILS
+
+const unsigned int ofxParticleTrails::NO_SLOT;
+
+//--------------------------------------------------------------
+ofxParticleTrails::ofxParticleTrails(unsigned int length, unsigned int maxSlots) :
+	_length(length < 2 ? 2 : length), _maxSlots(maxSlots), _numAllocated(0) {}
+
+//--------------------------------------------------------------
+unsigned int ofxParticleTrails::allocate() {
+	unsigned int slot;
+	if(!_free.empty()) {
+		slot = _free.back();
+		_free.pop_back();
+	}
+	else {
+		if(_maxSlots > 0 && _slots.size() >= _maxSlots) {
+			return NO_SLOT;
+		}
+		slot = _slots.size();
+		Slot empty = {0, 0, false};
+		_slots.push_back(empty);
+		_points.resize(_slots.size() * _length);
+	}
+	Slot& s = _slots[slot];
+	s.head = s.count = 0;
+	s.bUsed = true;
+	_numAllocated++;
+	return slot;
+}
+
+//--------------------------------------------------------------
+void ofxParticleTrails::release(unsigned int slot) {
+	if(!isAllocated(slot)) {
+		return;
+	}
+	_slots[slot].bUsed = false;
+	_free.push_back(slot);
+	_numAllocated--;
+}
+
+//--------------------------------------------------------------
+void ofxParticleTrails::clear() {
+	_free.clear();
+	for(int i = _slots.size()-1; i >= 0; --i) { // hand out low slots first
+		_slots[i].bUsed = false;
+		_free.push_back(i);
+	}
+	_numAllocated = 0;
+}
+
+//--------------------------------------------------------------
+void ofxParticleTrails::push(unsigned int slot, float x, float y) {
+	if(!isAllocated(slot)) {
+		return;
+	}
+	Slot& s = _slots[slot];
+	_points[slot * _length + s.head].set(x, y);
+	s.head = (s.head + 1) % _length;
+	if(s.count < _length) {
+		s.count++;
+	}
+}
+
+//--------------------------------------------------------------
+void ofxParticleTrails::reset(unsigned int slot) {
+	if(isAllocated(slot)) {
+		_slots[slot].head = _slots[slot].count = 0;
+	}
+}
+
+//--------------------------------------------------------------
+const ofVec2f& ofxParticleTrails::get(unsigned int slot, unsigned int i) {
+	static ofVec2f none;
+	if(i >= size(slot)) {
+		ofLogWarning("ofxParticleTrails") << "point " << i << " out of range for slot " << slot;
+		return none;
+	}
+	const Slot& s = _slots[slot];
+	unsigned int oldest = (s.head + _length - s.count) % _length;
+	return _points[slot * _length + (oldest + i) % _length];
+}
+
+//--------------------------------------------------------------
+unsigned int ofxParticleTrails::getSpans(unsigned int slot,
+                                         const ofVec2f*& first, unsigned int& firstSize,
+                                         const ofVec2f*& second, unsigned int& secondSize) {
+	first = second = NULL;
+	firstSize = secondSize = 0;
+	unsigned int count = size(slot);
+	if(count == 0) {
+		return 0;
+	}
+	const Slot& s = _slots[slot];
+	const ofVec2f* ring = &_points[slot * _length];
+	unsigned int oldest = (s.head + _length - count) % _length;
+	first = ring + oldest;
+	firstSize = std::min(count, _length - oldest);
+	if(firstSize < count) {
+		second = ring;
+		secondSize = count - firstSize;
+	}
+	return count;
+}
+
+//--------------------------------------------------------------
+void ofxParticleTrails::getPoints(unsigned int slot, std::vector<ofVec2f>& points) {
+	const ofVec2f *first, *second;
+	unsigned int firstSize, secondSize;
+	getSpans(slot, first, firstSize, second, secondSize);
+	points.clear();
+	if(firstSize > 0) {
+		points.insert(points.end(), first, first + firstSize);
+	}
+	if(secondSize > 0) {
+		points.insert(points.end(), second, second + secondSize);
+	}
+}
+
+//--------------------------------------------------------------
+void ofxParticleTrails::addRibbon(unsigned int slot, float width, ofMesh& mesh, bool taper) {
+	getPoints(slot, _scratch);
+	unsigned int count = _scratch.size();
+	if(count < 2) {
+		return;
+	}
+
+	// 2 vertices per point offset along the normal of the trail direction
+	ofIndexType base = mesh.getNumVertices();
+	for(unsigned int i = 0; i < count; ++i) {
+		const ofVec2f& prev = _scratch[i > 0 ? i-1 : i];
+		const ofVec2f& next = _scratch[i < count-1 ? i+1 : i];
+		float dx = next.x - prev.x, dy = next.y - prev.y;
+		float length = sqrtf(dx*dx + dy*dy);
+		float u = (float) i / (count-1);
+		float half = (taper ? width * u : width) / 2;
+		float nx = 0, ny = 0;
+		if(length > 0) {
+			nx = -dy / length * half;
+			ny = dx / length * half;
+		}
+		mesh.addVertex(ofVec3f(_scratch[i].x + nx, _scratch[i].y + ny));
+		mesh.addTexCoord(ofVec2f(u, 0));
+		mesh.addVertex(ofVec3f(_scratch[i].x - nx, _scratch[i].y - ny));
+		mesh.addTexCoord(ofVec2f(u, 1));
+	}
+
+	// 2 triangles per segment
+	for(unsigned int i = 0; i < count-1; ++i) {
+		ofIndexType v = base + i * 2;
+		mesh.addIndex(v);
+		mesh.addIndex(v+1);
+		mesh.addIndex(v+2);
+		mesh.addIndex(v+1);
+		mesh.addIndex(v+3);
+		mesh.addIndex(v+2);
+	}
+}
+
+//--------------------------------------------------------------
+void ofxParticleTrails::setLength(unsigned int length) {
+	_length = length < 2 ? 2 : length;
+	_points.resize(_slots.size() * _length);
+	for(unsigned int i = 0; i < _slots.size(); ++i) {
+		_slots[i].head = _slots[i].count = 0;
+	}
+}
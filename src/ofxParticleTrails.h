@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#pragma once
+
+#include <vector>
+
+#include "ofVectorMath.h"
+#include "ofMesh.h"
+
+/**
+	\class  ParticleTrails
+	\brief  position history for particle trails & ribbons
+
+	all trails share one slab of points split into fixed length ring buffers
+	(slots), a particle gets a slot with allocate(), adds its position each
+	frame with push(), & gives the slot back with release() when it dies, so
+	there are no per particle allocations or shifting once the slab has grown
+	to the number of particles
+
+	the particle managers handle the slots for you, see
+	ofxParticleManager::setTrails()
+
+	read a trail oldest first with get() or without copying with getSpans(),
+	which returns the 2 contiguous parts of the ring, or add it to a mesh as a
+	ribbon with addRibbon()
+**/
+class ofxParticleTrails {
+	public:
+
+		/// returned by allocate() when there is no room
+		static const unsigned int NO_SLOT = 0xFFFFFFFF;
+
+		/// length is the number of points kept per trail, maxSlots limits the
+		/// slab size, 0 for unlimited
+		ofxParticleTrails(unsigned int length=16, unsigned int maxSlots=0);
+
+	/// \section Slots
+
+		/// get an empty trail slot, returns NO_SLOT if maxSlots are in use
+		unsigned int allocate();
+
+		/// give a slot back for reuse
+		void release(unsigned int slot);
+
+		/// release all slots, keeps the slab memory
+		void clear();
+
+		/// is a slot in use?
+		bool isAllocated(unsigned int slot) {
+			return slot < _slots.size() && _slots[slot].bUsed;
+		}
+
+		/// number of slots in use
+		unsigned int getNumAllocated() {return _numAllocated;}
+
+	/// \section Points
+
+		/// add the newest point, overwrites the oldest point when full
+		void push(unsigned int slot, float x, float y);
+
+		/// remove all points from a trail
+		void reset(unsigned int slot);
+
+		/// number of points in a trail
+		unsigned int size(unsigned int slot) {
+			return isAllocated(slot) ? _slots[slot].count : 0;
+		}
+
+		/// get a point, 0 is the oldest
+		const ofVec2f& get(unsigned int slot, unsigned int i);
+
+		/// get the newest point
+		const ofVec2f& getNewest(unsigned int slot) {return get(slot, size(slot)-1);}
+
+		/// get the points without copying as 2 contiguous spans, oldest
+		/// first, the second span is empty if the ring hasn't wrapped,
+		/// returns the total number of points
+		unsigned int getSpans(unsigned int slot,
+		                      const ofVec2f*& first, unsigned int& firstSize,
+		                      const ofVec2f*& second, unsigned int& secondSize);
+
+		/// copy the points, oldest first
+		void getPoints(unsigned int slot, std::vector<ofVec2f>& points);
+
+		/// append a trail as a ribbon of triangles to a mesh, the ribbon is
+		/// width wide at the newest point & tapers to 0 at the oldest if
+		/// taper is set, texture coords run from 0 at the oldest to 1 at the
+		/// newest point along x & 0 to 1 across y, set the mesh mode to
+		/// OF_PRIMITIVE_TRIANGLES
+		void addRibbon(unsigned int slot, float width, ofMesh& mesh, bool taper=true);
+
+	/// \section Settings
+
+		/// points per trail, changing this resets all trails
+		inline unsigned int getLength() {return _length;}
+		void setLength(unsigned int length);
+
+		/// slot limit, 0 for unlimited
+		inline unsigned int getMaxSlots() {return _maxSlots;}
+		void setMaxSlots(unsigned int maxSlots) {_maxSlots = maxSlots;}
+
+	private:
+
+		/// a ring buffer in the slab
+		struct Slot {
+			unsigned int head;  ///< next point to write
+			unsigned int count; ///< number of points
+			bool bUsed;         ///< allocated?
+		};
+
+		unsigned int _length;       ///< points per slot
+		unsigned int _maxSlots;     ///< slot limit, 0 is unlimited
+		unsigned int _numAllocated; ///< slots in use
+		std::vector<ofVec2f> _points;     ///< the slab, length points per slot
+		std::vector<Slot> _slots;         ///< slot rings
+		std::vector<unsigned int> _free;  ///< released slots
+		std::vector<ofVec2f> _scratch;    ///< ribbon points
+};
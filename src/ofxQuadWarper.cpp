@@ -105,22 +105,26 @@ void ofxQuadWarper::reset() {
 #ifndef OFX_APP_UTILS_NO_XML
 
 bool ofxQuadWarper::loadSettings(const string xmlFile) {
+	return readSettings(xmlFile, _warpPoints);
+}
+
+bool ofxQuadWarper::readSettings(const string xmlFile, ofVec2f points[4]) {
 	
 	ofxXmlSettings xml;
 	if(!xml.loadFile(xmlFile))
 		return false;
 		
-	_warpPoints[0].x = xml.getValue("quad:upperLeft:x", 0.0);
-	_warpPoints[0].y = xml.getValue("quad:upperLeft:y", 0.0);
+	points[0].x = xml.getValue("quad:upperLeft:x", 0.0);
+	points[0].y = xml.getValue("quad:upperLeft:y", 0.0);
 	
-	_warpPoints[1].x = xml.getValue("quad:upperRight:x", 1.0);
-	_warpPoints[1].y = xml.getValue("quad:upperRight:y", 0.0);
+	points[1].x = xml.getValue("quad:upperRight:x", 1.0);
+	points[1].y = xml.getValue("quad:upperRight:y", 0.0);
 	
-	_warpPoints[2].x = xml.getValue("quad:lowerRight:x", 1.0);
-	_warpPoints[2].y = xml.getValue("quad:lowerRight:y", 1.0);
+	points[2].x = xml.getValue("quad:lowerRight:x", 1.0);
+	points[2].y = xml.getValue("quad:lowerRight:y", 1.0);
 	
-	_warpPoints[3].x = xml.getValue("quad:lowerLeft:x", 0.0);
-	_warpPoints[3].y = xml.getValue("quad:lowerLeft:y", 1.0);
+	points[3].x = xml.getValue("quad:lowerLeft:x", 0.0);
+	points[3].y = xml.getValue("quad:lowerLeft:y", 1.0);
 	
 	return true;
 }
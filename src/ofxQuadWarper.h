@@ -39,6 +39,11 @@ class ofxQuadWarper {
 		/// load/save the quad coords from/to an xml file
 		bool loadSettings(const string xmlFile="quadWarper.xml");
 		void saveSettings(const string xmlFile="quadWarper.xml");
+		
+		/// read the quad coords from an xml file into points without applying
+		/// them, does not touch any warper state so it's safe to call from
+		/// another thread
+		static bool readSettings(const string xmlFile, ofVec2f points[4]);
 
 #endif
 		
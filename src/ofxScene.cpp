@@ -10,6 +10,53 @@
  */
 #include "ofxScene.h"
 
+/// SCENE
+
+//--------------------------------------------------------------
+ofImage* ofxScene::loadImage(const std::string& path) {
+	ofxSceneImageAsset* asset = (ofxSceneImageAsset*) loadAsset(new ofxSceneImageAsset(path));
+	return asset != NULL ? &asset->image : NULL;
+}
+
+//--------------------------------------------------------------
+ofTrueTypeFont* ofxScene::loadFont(const std::string& path, int size, bool antialiased,
+                                   bool fullCharacterSet, bool makeContours) {
+	ofxSceneFontAsset* asset = (ofxSceneFontAsset*) loadAsset(
+		new ofxSceneFontAsset(path, size, antialiased, fullCharacterSet, makeContours));
+	return asset != NULL ? &asset->font : NULL;
+}
+
+//--------------------------------------------------------------
+ofBuffer* ofxScene::loadData(const std::string& path, bool binary) {
+	ofxSceneDataAsset* asset = (ofxSceneDataAsset*) loadAsset(new ofxSceneDataAsset(path, binary));
+	return asset != NULL ? &asset->buffer : NULL;
+}
+
+//--------------------------------------------------------------
+ofxSceneAsset* ofxScene::loadAsset(ofxSceneAsset* asset) {
+	if(_assetCache == NULL) {
+		ofLogWarning("ofxScene") << "cannot load assets, scene \"" << _name
+			<< "\" has not been added to a scene manager";
+		delete asset;
+		return NULL;
+	}
+	asset = _assetCache->acquire(asset);
+	if(asset != NULL) {
+		_assets.push_back(asset);
+	}
+	return asset;
+}
+
+//--------------------------------------------------------------
+void ofxScene::releaseAssets() {
+	if(_assetCache != NULL) {
+		for(unsigned int i = 0; i < _assets.size(); ++i) {
+			_assetCache->release(_assets[i]);
+		}
+	}
+	_assets.clear();
+}
+
 /// RUNNER SCENE
 
 //--------------------------------------------------------------
@@ -19,8 +66,10 @@ ofxScene::RunnerScene::RunnerScene(ofxScene* scene) {
 
 //--------------------------------------------------------------
 ofxScene::RunnerScene::~RunnerScene() {
-	if(scene != NULL)
+	if(scene != NULL) {
+		scene->releaseAssets();
 		delete scene;
+	}
 }
 
 //--------------------------------------------------------------
@@ -28,6 +77,7 @@ void ofxScene::RunnerScene::setup() {
 	if(!scene->_bSetup) {
 		scene->setup();
 		scene->_bSetup = true;
+		scene->_bInvalidated = true;
 	}
 }
 
@@ -35,18 +85,32 @@ void ofxScene::RunnerScene::setup() {
 void ofxScene::RunnerScene::update() {
 	if(!scene->_bSetup || !scene->_bRunning)
 		return;
+		
+	scene->_parameters.sync();
 
 	if(scene->_bEntering) {
-		scene->updateEnter();
+		if(scene->_bManagedTransition) {
+			scene->update();
+		}
+		else {
+			scene->updateEnter();
+		}
 		scene->_bEnteringFirst = false;
 	}
 	else if(scene->_bExiting) {
-		scene->updateExit();
+		if(scene->_bManagedTransition) {
+			scene->update();
+		}
+		else {
+			scene->updateExit();
+		}
 		scene->_bExitingFirst = false;
 	}
 	else {
 		scene->update();
 	}
+	
+	scene->_parameters.clearDirty();
 }
 		
 //--------------------------------------------------------------
@@ -56,10 +120,29 @@ void ofxScene::RunnerScene::draw() {
 	scene->draw();
 }
 
+//--------------------------------------------------------------
+void ofxScene::RunnerScene::setTransition(bool managed, float progress) {
+	scene->_bManagedTransition = managed;
+	scene->_transitionProgress = progress;
+}
+
+//--------------------------------------------------------------
+bool ofxScene::RunnerScene::checkInvalidated() {
+	bool invalidated = scene->_bInvalidated;
+	scene->_bInvalidated = false;
+	return invalidated;
+}
+
 //--------------------------------------------------------------
 void ofxScene::RunnerScene::exit() {
 	scene->exit();
 	if(!scene->_bSingleSetup) {
 		scene->_bSetup = false;
+		scene->releaseAssets(); // reacquired by the next setup()
 	}
 }
+
+//--------------------------------------------------------------
+void ofxScene::RunnerScene::setAssetCache(ofxSceneAssetCache* cache) {
+	scene->_assetCache = cache;
+}
@@ -12,6 +12,9 @@
 
 #include "ofxApp.h"
 #include "ofxTimer.h"
+#include "ofxParameterBinding.h"
+#include "ofxEventRouter.h"
+#include "ofxSceneAssetCache.h"
 
 /**
 	\class  Scene
@@ -33,7 +36,10 @@ class ofxScene :
 			_name(name), _bSetup(false), _bRunning(true),
 			_bEntering(false), _bEnteringFirst(false),
 			_bExiting(false), _bExitingFirst(false),
-			_bDone(false), _bSingleSetup(singleSetup) {}
+			_bDone(false), _bSingleSetup(singleSetup),
+			_bStatic(false), _bInvalidated(true), _bThreadSafeUpdate(false),
+			_bManagedTransition(false), _transitionProgress(1),
+			_assetCache(NULL) {}
 		virtual ~ofxScene() {}
 		
 	/// \section Main
@@ -76,6 +82,14 @@ class ofxScene :
 		/// is this scene exiting for the first time?
 		inline bool isExitingFirst()    {return _bExitingFirst;}
 
+		/// the eased progress of the scene manager's transition, 0-1, while
+		/// this scene is entering or exiting & 1 otherwise
+		///
+		/// when the scene manager has a transition set, it runs the enter &
+		/// exit for you: update() is called instead of updateEnter() &
+		/// updateExit() & the scene is finished when the transition ends
+		inline float getTransitionProgress() {return _transitionProgress;}
+
 		/// this scene is done and wants to start exiting, note: does not start exiting
 		inline void done()              {_bDone = true;}
 
@@ -103,11 +117,83 @@ class ofxScene :
 		inline void setSingleSetup(bool single) {_bSingleSetup = single;}
 		inline bool usingSingleSetup()          {return _bSingleSetup;}
 		
+		/// a static scene's drawing only changes when it calls invalidate(),
+		/// so the scene manager can draw it once into a cached fbo & reuse
+		/// the image on the following frames when caching is enabled
+		///
+		/// note: the cache is not used while entering or exiting
+		inline void setStatic(bool yesno) {_bStatic = yesno; _bInvalidated = true;}
+		inline bool isStatic()            {return _bStatic;}
+		
+		/// the scene's drawing changed, redraw the cached image on the next draw
+		inline void invalidate()     {_bInvalidated = true;}
+		inline bool isInvalidated() {return _bInvalidated;}
+		
+		/// is this scene's update(), updateEnter(), & updateExit() safe to call
+		/// from another thread? (false by default)
+		///
+		/// if so, the scene manager can update it in parallel with another
+		/// thread safe scene during overlapping transitions, the update must
+		/// not make GL calls or touch other scenes & scene manager transport
+		/// calls made during the update are deferred until both are done
+		inline void setThreadSafeUpdate(bool yesno) {_bThreadSafeUpdate = yesno;}
+		inline bool isThreadSafeUpdate()            {return _bThreadSafeUpdate;}
+		
+		/// bound parameters for this scene
+		///
+		/// add your ofxBoundParameters here and they are synced automatically
+		/// before each update, isDirty() is true during the update in which
+		/// a parameter changed and the dirty flags are cleared afterwards
+		inline ofxParameterGroup& getParameters() {return _parameters;}
+		
+		/// input event subscribers for this scene
+		///
+		/// when event routing is enabled in ofxApp, only the handlers
+		/// subscribed here are called while this scene is current, ie:
+		///     getEventRouter().add(ofxInputEvent::MOUSE_PRESSED, this, &MyScene::pressed);
+		inline ofxEventRouter& getEventRouter() {return _eventRouter;}
+		
+	/// \section Assets
+		
+		/// load assets through the scene manager's shared asset cache, an
+		/// asset used by several scenes is only loaded once, call these in
+		/// setup(), ie:
+		///     bg = loadImage("bg.png");
+		///
+		/// the scene keeps a reference to each asset until releaseAssets(),
+		/// which is called automatically on exit() when not using single
+		/// setup & on removal, so setup() gets the same assets back from the
+		/// cache on the next entry
+		///
+		/// returns NULL if the asset couldn't be loaded or the scene has not
+		/// been added to a scene manager
+		ofImage* loadImage(const std::string& path);
+		ofTrueTypeFont* loadFont(const std::string& path, int size, bool antialiased=true,
+		                         bool fullCharacterSet=false, bool makeContours=false);
+		ofBuffer* loadData(const std::string& path, bool binary=false);
+		
+		/// load your own ofxSceneAsset subclass, takes ownership of asset
+		ofxSceneAsset* loadAsset(ofxSceneAsset* asset);
+		
+		/// give back all of this scene's asset references
+		void releaseAssets();
+		
+		/// the scene manager's asset cache, NULL if not added yet
+		inline ofxSceneAssetCache* getAssetCache() {return _assetCache;}
+		
 	private:
 	
 		std::string _name; ///< the name of this scene
+		ofxParameterGroup _parameters; ///< bound parameters
+		ofxEventRouter _eventRouter;   ///< input event subscribers
 		bool _bSetup, _bRunning, _bEntering, _bEnteringFirst,
 			 _bExiting, _bExitingFirst, _bDone, _bSingleSetup;
+		bool _bStatic, _bInvalidated; ///< draw caching flags
+		bool _bThreadSafeUpdate;      ///< can update on another thread?
+		bool _bManagedTransition;     ///< is the manager running the transition?
+		float _transitionProgress;    ///< manager transition progress
+		ofxSceneAssetCache* _assetCache;     ///< shared asset cache
+		std::vector<ofxSceneAsset*> _assets; ///< acquired assets
 
 	public:
 	
@@ -132,6 +218,17 @@ class ofxScene :
 				void draw();
 				void exit();
 				
+				/// set whether the scene manager is running the enter/exit
+				/// transition & its progress
+				void setTransition(bool managed, float progress);
+				
+				/// has the scene been invalidated since the last call?
+				/// clears the flag
+				bool checkInvalidated();
+				
+				/// set the shared asset cache
+				void setAssetCache(ofxSceneAssetCache* cache);
+				
 				ofxScene* scene;
 		};
 		
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#include "ofxSceneAssetCache.h"
+
+#include "ofLog.h"
+#include "ofUtils.h"
+
+/// SCENE ASSETS
+
+//--------------------------------------------------------------
+bool ofxSceneImageAsset::load() {
+	return image.loadImage(path);
+}
+
+//--------------------------------------------------------------
+unsigned int ofxSceneImageAsset::getBytes() {
+	unsigned int bytes = image.getWidth() * image.getHeight() *
+		image.getPixelsRef().getNumChannels();
+	return image.isUsingTexture() ? bytes * 2 : bytes; // pixels & texture
+}
+
+//--------------------------------------------------------------
+ofxSceneFontAsset::ofxSceneFontAsset(const std::string& path, int size, bool antialiased,
+                                     bool fullCharacterSet, bool makeContours) :
+	ofxSceneAsset("font:" + ofToDataPath(path, true) + ":" + ofToString(size) + ":" +
+		ofToString(antialiased) + ofToString(fullCharacterSet) + ofToString(makeContours)),
+	path(ofToDataPath(path, true)), size(size), antialiased(antialiased),
+	fullCharacterSet(fullCharacterSet), makeContours(makeContours) {}
+
+//--------------------------------------------------------------
+bool ofxSceneFontAsset::load() {
+	return font.loadFont(path, size, antialiased, fullCharacterSet, makeContours);
+}
+
+//--------------------------------------------------------------
+unsigned int ofxSceneFontAsset::getBytes() {
+	// glyph atlas estimate: a line height square per character, luminance & alpha
+	unsigned int glyph = font.getLineHeight();
+	return font.getNumCharacters() * glyph * glyph * 2;
+}
+
+//--------------------------------------------------------------
+bool ofxSceneDataAsset::load() {
+	if(!ofFile::doesFileExist(path)) {
+		return false;
+	}
+	buffer = ofBufferFromFile(path, binary);
+	return true;
+}
+
+/// SCENE ASSET CACHE
+
+//--------------------------------------------------------------
+ofxSceneAssetCache::ofxSceneAssetCache() :
+	_budget(128*1024*1024), _residentBytes(0), _unusedBytes(0), _numUnused(0),
+	_releaseCount(0), _hits(0), _misses(0), _evictions(0) {}
+
+//--------------------------------------------------------------
+ofxSceneAssetCache::~ofxSceneAssetCache() {
+	clear();
+}
+
+//--------------------------------------------------------------
+ofxSceneAsset* ofxSceneAssetCache::acquire(ofxSceneAsset* asset) {
+	if(asset == NULL) {
+		ofLogWarning("ofxSceneAssetCache") << "cannot acquire NULL asset";
+		return NULL;
+	}
+
+	// already loaded?
+	std::map<std::string, Entry>::iterator iter = _assets.find(asset->getKey());
+	if(iter != _assets.end()) {
+		Entry& entry = iter->second;
+		if(entry.asset != asset) {
+			delete asset;
+		}
+		if(entry.refs == 0) { // back off the LRU list
+			_unusedBytes -= entry.bytes;
+			_numUnused--;
+		}
+		entry.refs++;
+		_hits++;
+		return entry.asset;
+	}
+
+	// load
+	_misses++;
+	if(!asset->load()) {
+		ofLogWarning("ofxSceneAssetCache") << "couldn't load \"" << asset->getKey() << "\"";
+		delete asset;
+		return NULL;
+	}
+	Entry entry;
+	entry.asset = asset;
+	entry.refs = 1;
+	entry.bytes = asset->getBytes();
+	entry.lastUsed = _releaseCount;
+	if(!_makeRoom(entry.bytes)) {
+		ofLogVerbose("ofxSceneAssetCache") << "over budget loading \""
+			<< asset->getKey() << "\", all other assets are in use";
+	}
+	_assets.insert(std::make_pair(asset->getKey(), entry));
+	_residentBytes += entry.bytes;
+	return asset;
+}
+
+//--------------------------------------------------------------
+void ofxSceneAssetCache::release(ofxSceneAsset* asset) {
+	if(asset == NULL) {
+		return;
+	}
+	std::map<std::string, Entry>::iterator iter = _assets.find(asset->getKey());
+	if(iter == _assets.end() || iter->second.asset != asset || iter->second.refs == 0) {
+		ofLogWarning("ofxSceneAssetCache") << "cannot release \""
+			<< asset->getKey() << "\", not acquired";
+		return;
+	}
+	Entry& entry = iter->second;
+	entry.refs--;
+	if(entry.refs == 0) { // onto the LRU list
+		entry.lastUsed = ++_releaseCount;
+		_unusedBytes += entry.bytes;
+		_numUnused++;
+		_makeRoom(0);
+	}
+}
+
+//--------------------------------------------------------------
+ofxSceneAsset* ofxSceneAssetCache::find(const std::string& key) {
+	std::map<std::string, Entry>::iterator iter = _assets.find(key);
+	return iter != _assets.end() ? iter->second.asset : NULL;
+}
+
+//--------------------------------------------------------------
+void ofxSceneAssetCache::clearUnused() {
+	std::map<std::string, Entry>::iterator iter = _assets.begin();
+	while(iter != _assets.end()) {
+		if(iter->second.refs == 0) {
+			_free(iter++);
+		}
+		else {
+			++iter;
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void ofxSceneAssetCache::clear() {
+	std::map<std::string, Entry>::iterator iter;
+	for(iter = _assets.begin(); iter != _assets.end(); ++iter) {
+		delete iter->second.asset;
+	}
+	_assets.clear();
+	_residentBytes = _unusedBytes = 0;
+	_numUnused = 0;
+}
+
+//--------------------------------------------------------------
+void ofxSceneAssetCache::setBudget(unsigned int bytes) {
+	_budget = bytes;
+	_makeRoom(0);
+}
+
+/* ***** PRIVATE ***** */
+
+//--------------------------------------------------------------
+void ofxSceneAssetCache::_free(std::map<std::string, Entry>::iterator iter) {
+	Entry& entry = iter->second;
+	_residentBytes -= entry.bytes;
+	if(entry.refs == 0) {
+		_unusedBytes -= entry.bytes;
+		_numUnused--;
+	}
+	delete entry.asset;
+	_assets.erase(iter);
+}
+
+//--------------------------------------------------------------
+bool ofxSceneAssetCache::_makeRoom(unsigned int bytes) {
+	while(_residentBytes + bytes > _budget && _numUnused > 0) {
+		std::map<std::string, Entry>::iterator iter, oldest = _assets.end();
+		for(iter = _assets.begin(); iter != _assets.end(); ++iter) {
+			if(iter->second.refs == 0 &&
+			   (oldest == _assets.end() || iter->second.lastUsed < oldest->second.lastUsed)) {
+				oldest = iter;
+			}
+		}
+		ofLogVerbose("ofxSceneAssetCache") << "freeing \""
+			<< oldest->first << "\", over budget";
+		_free(oldest);
+		_evictions++;
+	}
+	return _residentBytes + bytes <= _budget;
+}
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#pragma once
+
+#include <map>
+#include <string>
+
+#include "ofImage.h"
+#include "ofTrueTypeFont.h"
+#include "ofFileUtils.h"
+#include "ofUtils.h"
+
+/**
+	\class  SceneAsset
+	\brief  a loadable asset shared through an ofxSceneAssetCache
+
+	the key identifies the asset by type, path, & load parameters, assets with
+	the same key are the same decoded asset, subclass & implement load() &
+	getBytes() for your own asset types
+
+	the built in assets use the absolute data path, so "img.png" &
+	ofToDataPath("img.png", true) are the same asset, do the same in your
+	own asset keys
+**/
+class ofxSceneAsset {
+	public:
+
+		ofxSceneAsset(const std::string& key) : _key(key) {}
+		virtual ~ofxSceneAsset() {}
+
+		/// load the asset, returns false on error
+		virtual bool load() = 0;
+
+		/// the memory used by the loaded asset in bytes, estimates are fine
+		virtual unsigned int getBytes() = 0;
+
+		/// the unique type, path, & parameter key
+		inline const std::string& getKey() {return _key;}
+
+	private:
+
+		std::string _key; ///< cache key
+};
+
+/// an image & its texture
+class ofxSceneImageAsset : public ofxSceneAsset {
+	public:
+
+		ofxSceneImageAsset(const std::string& path) :
+			ofxSceneAsset("image:" + ofToDataPath(path, true)),
+			path(ofToDataPath(path, true)) {}
+
+		bool load();
+		unsigned int getBytes();
+
+		std::string path; ///< absolute file path
+		ofImage image;    ///< the loaded image
+};
+
+/// a font at a size, the glyph atlas size is estimated
+class ofxSceneFontAsset : public ofxSceneAsset {
+	public:
+
+		ofxSceneFontAsset(const std::string& path, int size, bool antialiased=true,
+		                  bool fullCharacterSet=false, bool makeContours=false);
+
+		bool load();
+		unsigned int getBytes();
+
+		std::string path;      ///< absolute file path
+		int size;              ///< font size
+		bool antialiased;      ///< load parameters, see ofTrueTypeFont::loadFont
+		bool fullCharacterSet;
+		bool makeContours;
+		ofTrueTypeFont font;   ///< the loaded font
+};
+
+/// the raw contents of a data file
+class ofxSceneDataAsset : public ofxSceneAsset {
+	public:
+
+		ofxSceneDataAsset(const std::string& path, bool binary=false) :
+			ofxSceneAsset((binary ? "binary:" : "text:") + ofToDataPath(path, true)),
+			path(ofToDataPath(path, true)), binary(binary) {}
+
+		bool load();
+		unsigned int getBytes() {return buffer.size();}
+
+		std::string path; ///< absolute file path
+		bool binary;      ///< read in binary mode?
+		ofBuffer buffer;  ///< the file contents
+};
+
+/**
+	\class  SceneAssetCache
+	\brief  reference counted assets shared between scenes
+
+	owned by ofxSceneManager, scenes load through it with ofxScene::loadImage(),
+	loadFont(), loadData(), & loadAsset() so an asset used by several scenes
+	is only decoded once & scenes using setSingleSetup(false) get their assets
+	back from the cache instead of reloading them on every entry
+
+	acquire() hands out an asset & counts a reference, release() gives it back,
+	unreferenced assets are kept loaded on a least recently used list & freed
+	when the resident memory goes over the budget, referenced assets are never
+	freed
+
+	load & release assets on the main thread, ie in setup() & exit(), images &
+	fonts make GL calls when they load
+**/
+class ofxSceneAssetCache {
+	public:
+
+		ofxSceneAssetCache();
+		virtual ~ofxSceneAssetCache();
+
+	/// \section Assets
+
+		/// get the cached asset with the same key & take a reference to it,
+		/// loads the asset on the first use
+		///
+		/// takes ownership of asset, it is deleted when there is already a
+		/// cached asset, returns NULL if the asset couldn't be loaded
+		ofxSceneAsset* acquire(ofxSceneAsset* asset);
+
+		/// give back a reference to an acquired asset, the asset stays
+		/// loaded until it's over the budget & unreferenced
+		void release(ofxSceneAsset* asset);
+
+		/// get a cached asset by key without taking a reference, ie
+		/// "image:" + ofToDataPath("img.png", true), returns NULL if not found
+		ofxSceneAsset* find(const std::string& key);
+
+		/// free all unreferenced assets
+		void clearUnused();
+
+		/// free all assets, pointers held by scenes are no longer valid
+		void clear();
+
+	/// \section Budget
+
+		/// max resident memory in bytes, the least recently released
+		/// unreferenced assets are freed first when over budget (default
+		/// 128 MB)
+		void setBudget(unsigned int bytes);
+		unsigned int getBudget() {return _budget;}
+
+	/// \section Stats
+
+		/// memory used by all loaded assets in bytes
+		unsigned int getResidentBytes() {return _residentBytes;}
+
+		/// memory used by unreferenced assets in bytes
+		unsigned int getUnusedBytes() {return _unusedBytes;}
+
+		/// number of loaded assets
+		unsigned int getNumAssets() {return _assets.size();}
+
+		/// number of unreferenced assets
+		unsigned int getNumUnused() {return _numUnused;}
+
+		/// number of acquires that found a loaded asset & that had to load
+		unsigned int getNumHits()   {return _hits;}
+		unsigned int getNumMisses() {return _misses;}
+
+		/// number of assets freed to stay under the budget
+		unsigned int getNumEvictions() {return _evictions;}
+
+		/// reset the hit, miss, & eviction counts
+		void resetStats() {_hits = _misses = _evictions = 0;}
+
+	private:
+
+		/// a loaded asset
+		struct Entry {
+			ofxSceneAsset* asset;  ///< the asset
+			unsigned int refs;     ///< number of references
+			unsigned int bytes;    ///< asset memory size
+			unsigned int lastUsed; ///< release count when the last reference was released
+		};
+
+		/// free an asset
+		void _free(std::map<std::string, Entry>::iterator iter);
+
+		/// free the least recently used unreferenced assets until there is
+		/// room for a number of bytes, returns false if there isn't enough
+		/// room
+		bool _makeRoom(unsigned int bytes);
+
+		std::map<std::string, Entry> _assets; ///< loaded assets by key
+
+		unsigned int _budget;        ///< max resident memory in bytes
+		unsigned int _residentBytes; ///< memory used by all assets
+		unsigned int _unusedBytes;   ///< memory used by unreferenced assets
+		unsigned int _numUnused;     ///< number of unreferenced assets
+		unsigned int _releaseCount;  ///< release counter for the LRU
+		unsigned int _hits, _misses, _evictions; ///< stats
+
+		ofxSceneAssetCache(const ofxSceneAssetCache& from); // not copyable
+		ofxSceneAssetCache& operator=(const ofxSceneAssetCache& from); // not assignable
+};
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#include "ofxSceneCommandQueue.h"
+
+#include "ofConstants.h"
+
+// atomic helpers, full barriers are a bit more than needed but keep this
+// simple & correct on both x86 & arm
+#ifdef TARGET_WIN32
+	#define OFX_ATOMIC_BARRIER() MemoryBarrier()
+	template <class T>
+	static inline T* atomicExchange(T* volatile* ptr, T* value) {
+		return (T*) InterlockedExchangePointer((PVOID volatile*) ptr, value);
+	}
+	static inline unsigned int atomicIncrement(volatile unsigned int* value) {
+		return (unsigned int) InterlockedIncrement((volatile LONG*) value);
+	}
+#else
+	#define OFX_ATOMIC_BARRIER() __sync_synchronize()
+	template <class T>
+	static inline T* atomicExchange(T* volatile* ptr, T* value) {
+		__sync_synchronize(); // test_and_set is only an acquire barrier
+		return __sync_lock_test_and_set(ptr, value);
+	}
+	static inline unsigned int atomicIncrement(volatile unsigned int* value) {
+		return __sync_add_and_fetch(value, 1);
+	}
+#endif
+
+/// SCENE COMMAND QUEUE
+
+//--------------------------------------------------------------
+ofxSceneCommandQueue::ofxSceneCommandQueue() :
+	_head(&_stub), _tail(&_stub), _nextTicket(0), _lastApplied(0) {
+	_stub.next = NULL;
+}
+
+//--------------------------------------------------------------
+ofxSceneCommandQueue::~ofxSceneCommandQueue() {
+	ofxSceneCommand command;
+	while(pop(command)) {} // free any remaining nodes
+}
+
+//--------------------------------------------------------------
+unsigned int ofxSceneCommandQueue::post(const ofxSceneCommand& command) {
+	Node* node = new Node;
+	node->command = command;
+	node->command.ticket = atomicIncrement(&_nextTicket);
+	unsigned int ticket = node->command.ticket; // node may be freed after push
+	push(node);
+	return ticket;
+}
+
+//--------------------------------------------------------------
+bool ofxSceneCommandQueue::pop(ofxSceneCommand& command) {
+	Node* tail = _tail;
+	Node* next = tail->next;
+	OFX_ATOMIC_BARRIER();
+
+	// skip over the stub
+	if(tail == &_stub) {
+		if(next == NULL)
+			return false;
+		_tail = next;
+		tail = next;
+		next = next->next;
+		OFX_ATOMIC_BARRIER();
+	}
+
+	if(next != NULL) {
+		_tail = next;
+		command = tail->command;
+		delete tail;
+		return true;
+	}
+
+	// a producer is between swapping the head & linking its node
+	Node* head = _head;
+	OFX_ATOMIC_BARRIER();
+	if(tail != head)
+		return false;
+
+	// tail is the last node, put the stub back behind it so it can be popped
+	push(&_stub);
+	next = tail->next;
+	OFX_ATOMIC_BARRIER();
+	if(next != NULL) {
+		_tail = next;
+		command = tail->command;
+		delete tail;
+		return true;
+	}
+	return false;
+}
+
+//--------------------------------------------------------------
+bool ofxSceneCommandQueue::empty() {
+	Node* next = _tail->next;
+	return _tail == &_stub && next == NULL;
+}
+
+//--------------------------------------------------------------
+void ofxSceneCommandQueue::setApplied(unsigned int ticket) {
+	unsigned int applied = _lastApplied;
+	if(ticket <= applied)
+		return;
+	_appliedAhead.insert(ticket);
+
+	// advance over all contiguous applied tickets
+	std::set<unsigned int>::iterator iter = _appliedAhead.begin();
+	while(iter != _appliedAhead.end() && *iter == applied+1) {
+		applied++;
+		_appliedAhead.erase(iter++);
+	}
+	OFX_ATOMIC_BARRIER();
+	_lastApplied = applied;
+}
+
+bool ofxSceneCommandQueue::isApplied(unsigned int ticket) {
+	return getLastApplied() >= ticket;
+}
+
+unsigned int ofxSceneCommandQueue::getLastApplied() {
+	unsigned int applied = _lastApplied;
+	OFX_ATOMIC_BARRIER();
+	return applied;
+}
+
+/* ***** PRIVATE ***** */
+
+//--------------------------------------------------------------
+void ofxSceneCommandQueue::push(Node* node) {
+	node->next = NULL;
+	Node* prev = atomicExchange(&_head, node);
+	OFX_ATOMIC_BARRIER();
+	prev->next = node; // links the node for the consumer
+}
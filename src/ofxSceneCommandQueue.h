@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#pragma once
+
+#include <string>
+#include <set>
+
+/**
+	\class  SceneCommand
+	\brief  a scene manager transport command
+**/
+struct ofxSceneCommand {
+
+	/// command types, same as the ofxSceneManager transport functions
+	enum Type {
+		NO_SCENE,
+		NEXT_SCENE,
+		PREV_SCENE,
+		GOTO_SCENE,      ///< goto the scene at index
+		GOTO_SCENE_NAME, ///< goto the scene with name
+		RUN,
+		RUN_TOGGLE
+	};
+
+	ofxSceneCommand(Type type=NO_SCENE, bool value=false, int index=0) :
+		type(type), value(value), index(index), ticket(0) {}
+
+	Type type;          ///< command type
+	bool value;         ///< now or run
+	int index;          ///< scene index for GOTO_SCENE
+	std::string name;   ///< scene name for GOTO_SCENE_NAME
+	unsigned int ticket; ///< set by the queue when posted
+};
+
+/**
+	\class  SceneCommandQueue
+	\brief  a lock free multiple producer, single consumer command queue
+
+	any number of threads can post commands, only one thread (the main thread
+	in the scene manager) may pop them, based on Dmitry Vyukov's intrusive
+	MPSC node based queue:
+	http://www.1024cores.net/home/lock-free-algorithms/queues/intrusive-mpsc-node-based-queue
+
+	each posted command gets an increasing ticket number, the consumer marks
+	tickets as applied so producers can check when their command went through,
+	tickets from different threads can be popped slightly out of order so a
+	ticket only counts as applied once all earlier tickets are too
+
+	posting allocates a node, popping frees it, checking an empty queue is a
+	single pointer load
+**/
+class ofxSceneCommandQueue {
+	public:
+
+		ofxSceneCommandQueue();
+		virtual ~ofxSceneCommandQueue();
+
+		/// add a command, thread safe, returns its ticket (> 0)
+		unsigned int post(const ofxSceneCommand& command);
+
+		/// get the oldest command, returns false if empty (consumer only)
+		///
+		/// note: may return false while a producer is in the middle of a post,
+		///       the command is returned by a later pop
+		bool pop(ofxSceneCommand& command);
+
+		/// is the queue empty? (consumer only)
+		bool empty();
+
+		/// mark a popped command's ticket as applied (consumer only)
+		void setApplied(unsigned int ticket);
+
+		/// has the command with this ticket been applied? thread safe
+		bool isApplied(unsigned int ticket);
+
+		/// the last ticket where it & all earlier tickets are applied,
+		/// 0 if none, thread safe
+		unsigned int getLastApplied();
+
+	private:
+
+		/// a queued command
+		struct Node {
+			Node* volatile next;
+			ofxSceneCommand command;
+		};
+
+		/// link a node in at the head
+		void push(Node* node);
+
+		Node* volatile _head; ///< newest node, written by producers
+		Node* _tail;          ///< oldest node, consumer only
+		Node _stub;           ///< placeholder so the queue is never empty
+
+		volatile unsigned int _nextTicket;  ///< last issued ticket
+		volatile unsigned int _lastApplied; ///< all tickets up to here are applied
+		std::set<unsigned int> _appliedAhead; ///< applied tickets after a gap
+
+		ofxSceneCommandQueue(const ofxSceneCommandQueue& from); // not copyable
+		ofxSceneCommandQueue& operator=(const ofxSceneCommandQueue& from); // not assignable
+};
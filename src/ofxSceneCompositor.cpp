@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#include "ofxSceneCompositor.h"
+
+#include "ofGraphics.h"
+#include "ofAppRunner.h"
+#include "ofxBitmapStringBatch.h"
+
+/// SCENE COMPOSITOR
+
+//--------------------------------------------------------------
+ofxSceneCompositor::ofxSceneCompositor() :
+	_width(0), _height(0), _bWindowSize(true), _numRedrawn(0) {}
+
+//--------------------------------------------------------------
+ofxSceneCompositor::~ofxSceneCompositor() {
+	clear();
+}
+
+//--------------------------------------------------------------
+ofxSceneLayer* ofxSceneCompositor::addLayer(const std::string& name, ofBlendMode mode) {
+	if(getLayer(name) != NULL) {
+		ofLogWarning("ofxSceneCompositor") << "layer \"" << name
+			<< "\" already added, only unique names allowed";
+		return NULL;
+	}
+	ofxSceneLayer* layer = new ofxSceneLayer(name, mode);
+	_layers.push_back(layer);
+	return layer;
+}
+
+//--------------------------------------------------------------
+void ofxSceneCompositor::removeLayer(const std::string& name) {
+	std::vector<ofxSceneLayer*>::iterator iter;
+	for(iter = _layers.begin(); iter != _layers.end(); ++iter) {
+		if((*iter)->getName() == name) {
+			(*iter)->_scenes.clear();
+			delete (*iter);
+			_layers.erase(iter);
+			return;
+		}
+	}
+	ofLogWarning("ofxSceneCompositor") << "could not find layer \"" << name << "\"";
+}
+
+//--------------------------------------------------------------
+void ofxSceneCompositor::clear() {
+	for(unsigned int i = 0; i < _layers.size(); ++i) {
+		_layers[i]->_scenes.clear();
+		delete _layers[i];
+	}
+	_layers.clear();
+}
+
+//--------------------------------------------------------------
+ofxSceneLayer* ofxSceneCompositor::getLayer(const std::string& name) {
+	for(unsigned int i = 0; i < _layers.size(); ++i) {
+		if(_layers[i]->getName() == name) {
+			return _layers[i];
+		}
+	}
+	return NULL;
+}
+
+ofxSceneLayer* ofxSceneCompositor::getLayerAt(unsigned int index) {
+	return index < _layers.size() ? _layers[index] : NULL;
+}
+
+//--------------------------------------------------------------
+void ofxSceneCompositor::markDirty() {
+	for(unsigned int i = 0; i < _layers.size(); ++i) {
+		_layers[i]->markDirty();
+	}
+}
+
+//--------------------------------------------------------------
+void ofxSceneCompositor::setSize(int w, int h) {
+	_width = w;
+	_height = h;
+	_bWindowSize = false;
+	markDirty();
+}
+
+//--------------------------------------------------------------
+void ofxSceneCompositor::setup(bool loadAll) {
+	for(unsigned int i = 0; i < _layers.size(); ++i) {
+		_layers[i]->_scenes.setup(loadAll);
+	}
+}
+
+//--------------------------------------------------------------
+void ofxSceneCompositor::update() {
+	for(unsigned int i = 0; i < _layers.size(); ++i) {
+		ofxSceneLayer* layer = _layers[i];
+		if(!layer->_bActive)
+			continue;
+
+		layer->_scenes.update();
+
+		// anything that can change what the layer looks like, scenes that
+		// are cacheable by the manager's rules keep the last image
+		ofxSceneManager& scenes = layer->_scenes;
+		ofxScene* scene = scenes.getCurrentScene();
+		if(scenes.isTransitioning() || scenes.getCurrentSceneIndex() != layer->_lastScene) {
+			layer->_bDirty = true;
+		}
+		else if(scene != NULL) {
+			bool cacheable = scene->isStatic() ||
+				(!scene->isRunning() && scenes.getCachePaused());
+			if(!cacheable || scene->isInvalidated()) {
+				layer->_bDirty = true;
+			}
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void ofxSceneCompositor::draw() {
+	if(_bWindowSize) {
+		_width = ofGetWidth();
+		_height = ofGetHeight();
+	}
+
+	_numRedrawn = 0;
+	for(unsigned int i = 0; i < _layers.size(); ++i) {
+		ofxSceneLayer* layer = _layers[i];
+		if(!layer->_bActive)
+			continue;
+
+		// redraw into the fbo only when something changed
+		_allocate(layer);
+		if(layer->_bDirty) {
+			// render the manager's cache & transition fbos first, fbos don't nest
+			layer->_scenes.drawOffscreen();
+			ofxBitmapStringBatch::suspend();
+			layer->_fbo.begin();
+			ofClear(0, 0, 0, 0);
+			layer->_scenes.draw();
+			layer->_fbo.end();
+			ofxBitmapStringBatch::resume();
+			layer->_bDirty = false;
+			layer->_lastScene = layer->_scenes.getCurrentSceneIndex();
+			_numRedrawn++;
+		}
+
+		// composite
+		ofPushStyle();
+		ofEnableBlendMode(layer->_blendMode);
+		ofSetColor(255, 255, 255, layer->_alpha * 255);
+		layer->_fbo.draw(0, 0, _width, _height);
+		ofPopStyle();
+	}
+}
+
+//--------------------------------------------------------------
+void ofxSceneCompositor::windowResized(int w, int h) {
+	if(_bWindowSize) {
+		_width = w;
+		_height = h;
+		markDirty();
+	}
+	for(unsigned int i = 0; i < _layers.size(); ++i) {
+		_layers[i]->_scenes.windowResized(w, h);
+	}
+}
+
+//--------------------------------------------------------------
+void ofxSceneCompositor::keyPressed(int key) {
+	for(int i = _layers.size()-1; i >= 0; --i) {
+		if(_layers[i]->_bActive) _layers[i]->_scenes.keyPressed(key);
+	}
+}
+
+void ofxSceneCompositor::keyReleased(int key) {
+	for(int i = _layers.size()-1; i >= 0; --i) {
+		if(_layers[i]->_bActive) _layers[i]->_scenes.keyReleased(key);
+	}
+}
+
+void ofxSceneCompositor::mouseMoved(int x, int y) {
+	for(int i = _layers.size()-1; i >= 0; --i) {
+		if(_layers[i]->_bActive) _layers[i]->_scenes.mouseMoved(x, y);
+	}
+}
+
+void ofxSceneCompositor::mouseDragged(int x, int y, int button) {
+	for(int i = _layers.size()-1; i >= 0; --i) {
+		if(_layers[i]->_bActive) _layers[i]->_scenes.mouseDragged(x, y, button);
+	}
+}
+
+void ofxSceneCompositor::mousePressed(int x, int y, int button) {
+	for(int i = _layers.size()-1; i >= 0; --i) {
+		if(_layers[i]->_bActive) _layers[i]->_scenes.mousePressed(x, y, button);
+	}
+}
+
+void ofxSceneCompositor::mouseReleased(int x, int y, int button) {
+	for(int i = _layers.size()-1; i >= 0; --i) {
+		if(_layers[i]->_bActive) _layers[i]->_scenes.mouseReleased(x, y, button);
+	}
+}
+
+/* ***** PRIVATE ***** */
+
+//--------------------------------------------------------------
+void ofxSceneCompositor::_allocate(ofxSceneLayer* layer) {
+	if(!layer->_fbo.isAllocated() ||
+	   (int) layer->_fbo.getWidth() != _width || (int) layer->_fbo.getHeight() != _height) {
+		layer->_fbo.allocate(_width, _height, GL_RGBA);
+		layer->_bDirty = true;
+	}
+}
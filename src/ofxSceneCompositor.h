@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#pragma once
+
+#include <vector>
+
+#include "ofFbo.h"
+#include "ofMath.h"
+
+#include "ofxSceneManager.h"
+
+/**
+	\class  SceneLayer
+	\brief  a compositor layer with its own scene manager
+
+	each layer has its own scenes & transport, ie
+	layer->getScenes().gotoScene("title"), & is drawn into its own fbo which
+	is blended onto the layers below it
+
+	the fbo is only redrawn when the layer is dirty: when it was marked dirty,
+	the current scene is changing, transitioning, entering, or exiting, or
+	the current scene is not cacheable by the scene manager's rules, see
+	ofxSceneManager::setCaching(); a static scene is redrawn only after it
+	calls invalidate() & a paused scene keeps its image if cachePaused is set
+
+	note: an animated layer is redrawn every frame, which costs an extra
+	full size fbo pass on top of drawing its scene, so make scenes that
+	don't change static or pause them with run(false)
+**/
+class ofxSceneLayer {
+	public:
+
+		/// get the layer name
+		inline const std::string& getName() {return _name;}
+
+		/// the scenes in this layer
+		inline ofxSceneManager& getScenes() {return _scenes;}
+
+		/// inactive layers are not updated or drawn (active by default)
+		inline void setActive(bool active) {_bActive = active; _bDirty = true;}
+		inline bool isActive()             {return _bActive;}
+
+		/// blend mode used when compositing (default OF_BLENDMODE_ALPHA)
+		inline void setBlendMode(ofBlendMode mode) {_blendMode = mode;}
+		inline ofBlendMode getBlendMode()          {return _blendMode;}
+
+		/// layer opacity when compositing, 0-1 (default 1)
+		inline void setAlpha(float alpha) {_alpha = ofClamp(alpha, 0, 1);}
+		inline float getAlpha()           {return _alpha;}
+
+		/// redraw the layer fbo on the next draw
+		inline void markDirty() {_bDirty = true;}
+
+		/// will the layer fbo be redrawn on the next draw?
+		inline bool isDirty()   {return _bDirty;}
+
+	private:
+
+		friend class ofxSceneCompositor;
+
+		ofxSceneLayer(const std::string& name, ofBlendMode mode) :
+			_name(name), _bActive(true), _blendMode(mode), _alpha(1),
+			_bDirty(true), _lastScene(-1) {}
+
+		std::string _name;       ///< layer name
+		ofxSceneManager _scenes; ///< layer scenes
+		bool _bActive;           ///< update & draw this layer?
+		ofBlendMode _blendMode;  ///< compositing blend mode
+		float _alpha;            ///< compositing opacity
+		bool _bDirty;            ///< redraw the fbo?
+		int _lastScene;          ///< current scene index when last drawn
+		ofFbo _fbo;              ///< render target
+};
+
+/**
+	\class  SceneCompositor
+	\brief  a stack of scene layers that update & draw together
+
+	layers are drawn in the order they were added, the first layer is on the
+	bottom, ie a background, content, & overlay/UI layer:
+
+	    compositor.addLayer("background");
+	    compositor.addLayer("content");
+	    compositor.addLayer("overlay", OF_BLENDMODE_ADD);
+	    compositor.getLayer("content")->getScenes().add(new MyScene());
+
+	call setup(), update(), draw(), & windowResized() from your app, input
+	events are forwarded to all active layers, top layer first
+**/
+class ofxSceneCompositor {
+	public:
+
+		ofxSceneCompositor();
+		virtual ~ofxSceneCompositor();
+
+	/// \section Layers
+
+		/// add a layer on top, returns NULL if the name is already used
+		ofxSceneLayer* addLayer(const std::string& name, ofBlendMode mode=OF_BLENDMODE_ALPHA);
+
+		/// remove (delete) a layer & its scenes
+		void removeLayer(const std::string& name);
+
+		/// remove (delete) all layers
+		void clear();
+
+		/// layer access, returns NULL if not found
+		ofxSceneLayer* getLayer(const std::string& name);
+		ofxSceneLayer* getLayerAt(unsigned int index);
+
+		/// returns the number of layers
+		unsigned int getNumLayers() {return _layers.size();}
+
+		/// mark all layers dirty
+		void markDirty();
+
+	/// \section Settings
+
+		/// set the size of the layer fbos, defaults to the window size
+		void setSize(int w, int h);
+		int getWidth()  {return _width;}
+		int getHeight() {return _height;}
+
+	/// \section Stats
+
+		/// number of layers redrawn during the last draw
+		unsigned int getNumRedrawn() {return _numRedrawn;}
+
+	/// \section Callbacks
+
+		/// setup the scenes in all layers
+		void setup(bool loadAll=true);
+
+		/// update all active layers
+		void update();
+
+		/// redraw dirty layers & composite all active layers
+		void draw();
+
+		/// resizes the fbos if using the window size & forwards to all layers
+		void windowResized(int w, int h);
+
+		void keyPressed(int key);
+		void keyReleased(int key);
+
+		void mouseMoved(int x, int y);
+		void mouseDragged(int x, int y, int button);
+		void mousePressed(int x, int y, int button);
+		void mouseReleased(int x, int y, int button);
+
+	private:
+
+		/// allocate a layer fbo at the current size if needed
+		void _allocate(ofxSceneLayer* layer);
+
+		std::vector<ofxSceneLayer*> _layers; ///< layers, bottom first
+		int _width, _height;      ///< fbo size
+		bool _bWindowSize;        ///< use the window size?
+		unsigned int _numRedrawn; ///< layers redrawn last draw
+};
@@ -10,17 +10,80 @@
  */
 #include "ofxSceneManager.h"
 
+#include "ofFbo.h"
+#include "ofGraphics.h"
+#include "ofAppRunner.h"
+#include "ofThread.h"
+#include "ofxBitmapStringBatch.h"
+#include "Poco/Event.h"
+
+/// SCENE UPDATE WORKER
+
+/// updates a scene on its own thread when signalled
+class ofxSceneUpdateWorker : public ofThread {
+	public:
+
+		ofxSceneUpdateWorker() : _runner(NULL), _bQuit(false) {}
+
+		/// start updating a scene, returns right away
+		void update(ofxScene::RunnerScene* runner) {
+			_runner = runner;
+			_start.set();
+		}
+
+		/// wait for the update to finish
+		void wait() {
+			_done.wait();
+		}
+
+		/// stop the thread
+		void quit() {
+			_bQuit = true;
+			_start.set();
+			waitForThread(false);
+		}
+
+	protected:
+
+		void threadedFunction() {
+			while(true) {
+				_start.wait();
+				if(_bQuit)
+					break;
+				_runner->update();
+				_done.set();
+			}
+		}
+
+		ofxScene::RunnerScene* _runner; ///< scene to update
+		bool _bQuit;                    ///< exit the thread?
+		Poco::Event _start, _done;      ///< update start & finish signals
+};
+
 /// SCENE MANAGER
 
 //--------------------------------------------------------------
 ofxSceneManager::ofxSceneManager() :
 	_currentScene(SCENE_NONE), _newScene(SCENE_NOCHANGE),
-	_bChangeNow(false), _minChangeTimeMS(100), _bSignalledAutoChange(false), _bOverlapTransitions(false)
+	_bChangeNow(false), _minChangeTimeMS(100), _bSignalledAutoChange(false), _bOverlapTransitions(false),
+	_bCaching(false), _bCachePaused(true), _cacheBudget(64*1024*1024),
+	_cacheMemory(0), _drawFrame(0),
+	_transition(NULL), _bTransitioning(false), _transitionProgress(1),
+	_fromRunner(NULL), _toRunner(NULL), _fromFbo(NULL), _toFbo(NULL),
+	_bOffscreenDrawn(false),
+	_bParallelUpdate(false), _bDeferCommands(false), _updateWorker(NULL)
 {
 	_sceneChangeTimer.set();
 	_currentScenePtr = NULL;
 }
 
+//--------------------------------------------------------------
+ofxSceneManager::~ofxSceneManager() {
+	setParallelUpdate(false);
+	clearCache();
+	setTransition(NULL);
+}
+
 //--------------------------------------------------------------
 ofxScene* ofxSceneManager::add(ofxScene* scene) {
 	if(scene == NULL) {
@@ -34,7 +97,9 @@ ofxScene* ofxSceneManager::add(ofxScene* scene) {
 		return NULL;
 	}
 	
-	_scenes.insert(_scenes.end(), pair<std::string,ofxScene::RunnerScene*>(scene->getName(), new ofxScene::RunnerScene(scene)));
+	ofxScene::RunnerScene* runner = new ofxScene::RunnerScene(scene);
+	runner->setAssetCache(&_assetCache);
+	_scenes.insert(_scenes.end(), pair<std::string,ofxScene::RunnerScene*>(scene->getName(), runner));
 	return scene;
 }
 		
@@ -51,6 +116,10 @@ void ofxSceneManager::remove(ofxScene* scene) {
 		ofxScene::RunnerScene* s = (*iter).second;
 		if(s->scene == scene) {
 			if(s != NULL) {
+				if(s == _fromRunner || s == _toRunner) {
+					_endTransition(false);
+				}
+				_releaseCache(s);
 				s->exit();
 				delete s;
 			}
@@ -64,6 +133,8 @@ void ofxSceneManager::remove(ofxScene* scene) {
 
 //--------------------------------------------------------------
 void ofxSceneManager::clear() {
+	_endTransition(false);
+	clearCache();
 	map<std::string,ofxScene::RunnerScene*>::iterator iter;
 	for(iter = _scenes.begin(); iter != _scenes.end(); ++iter) {
 		ofxScene::RunnerScene* s = (*iter).second;
@@ -93,6 +164,8 @@ void ofxSceneManager::setup(bool loadAll) {
 
 //--------------------------------------------------------------
 void ofxSceneManager::run(bool run) {
+	if(_defer(ofxSceneCommand::RUN, run))
+		return;
 	if(!_scenes.empty() && _currentScene >= 0) {
 		_currentScenePtr->run(run);
 		ofLogVerbose("ofxSceneManager") << "SCENE " << _currentScenePtr->getName()
@@ -113,13 +186,29 @@ bool ofxSceneManager::isRunning() {
 	return false;
 }
 
+//--------------------------------------------------------------
+bool ofxSceneManager::isTransitioning() {
+	if(_newScene != SCENE_NOCHANGE)
+		return true;
+	if(!_scenes.empty() && _currentScene >= 0) {
+		return _currentScenePtr->isEntering() || _currentScenePtr->isExiting();
+	}
+	return false;
+}
+
 //--------------------------------------------------------------
 void ofxSceneManager::noScene(bool now) {
+	if(_defer(ofxSceneCommand::NO_SCENE, now))
+		return;
 	if(_sceneChangeTimer.getDiff() < _minChangeTimeMS)
 		return;
 	
+	_endTransition(true); // finish any running transition first
 	if(!now && _currentScene > -1) {
 		_currentScenePtr->startExiting();
+		if(_transition != NULL) {
+			_startTransition(_currentRunnerScenePtr, NULL);
+		}
 	}
 	_bChangeNow = now;
 	_newScene = SCENE_NONE;
@@ -128,6 +217,8 @@ void ofxSceneManager::noScene(bool now) {
 
 //--------------------------------------------------------------
 void ofxSceneManager::nextScene(bool now) {
+	if(_defer(ofxSceneCommand::NEXT_SCENE, now))
+		return;
 	if(_currentScene+1 >= (int) _scenes.size()) {
 		gotoScene(0, now);
 	} else {
@@ -137,6 +228,8 @@ void ofxSceneManager::nextScene(bool now) {
 
 //--------------------------------------------------------------
 void ofxSceneManager::prevScene(bool now) {
+	if(_defer(ofxSceneCommand::PREV_SCENE, now))
+		return;
 	if(_currentScene-1 < 0) {
 		gotoScene(_scenes.size()-1, now);
 	} else {
@@ -146,6 +239,8 @@ void ofxSceneManager::prevScene(bool now) {
 
 //--------------------------------------------------------------
 void ofxSceneManager::gotoScene(unsigned int index, bool now) {
+	if(_defer(ofxSceneCommand::GOTO_SCENE, now, index))
+		return;
 	if(_scenes.empty() || index >= _scenes.size() ||
 	   _sceneChangeTimer.getDiff() < _minChangeTimeMS)
 		return;
@@ -156,6 +251,7 @@ void ofxSceneManager::gotoScene(unsigned int index, bool now) {
 		return;
 	}
 
+	_endTransition(true); // finish any running transition first
 	if(!now) {
 	
 		// tell current scene to exit
@@ -172,6 +268,11 @@ void ofxSceneManager::gotoScene(unsigned int index, bool now) {
 //--------------------- </CAMBIOS MASOTROS> ---------------------//
 	}
 	
+	if(_transition != NULL && !now) {
+		_startTransition(_currentScene > SCENE_NONE ? _currentRunnerScenePtr : NULL,
+		                 _newRunnerScenePtr);
+	}
+	
 	_newScene = index;
 	_bChangeNow = now;
     
@@ -189,6 +290,45 @@ void ofxSceneManager::gotoScene(std::string name, bool now) {
 	gotoScene(std::distance(_scenes.begin(), iter), now);
 }
 
+//--------------------------------------------------------------
+unsigned int ofxSceneManager::postRun(bool run) {
+	return _commandQueue.post(ofxSceneCommand(ofxSceneCommand::RUN, run));
+}
+
+unsigned int ofxSceneManager::postRunToggle() {
+	return _commandQueue.post(ofxSceneCommand(ofxSceneCommand::RUN_TOGGLE));
+}
+
+unsigned int ofxSceneManager::postNoScene(bool now) {
+	return _commandQueue.post(ofxSceneCommand(ofxSceneCommand::NO_SCENE, now));
+}
+
+unsigned int ofxSceneManager::postNextScene(bool now) {
+	return _commandQueue.post(ofxSceneCommand(ofxSceneCommand::NEXT_SCENE, now));
+}
+
+unsigned int ofxSceneManager::postPrevScene(bool now) {
+	return _commandQueue.post(ofxSceneCommand(ofxSceneCommand::PREV_SCENE, now));
+}
+
+unsigned int ofxSceneManager::postGotoScene(unsigned int index, bool now) {
+	return _commandQueue.post(ofxSceneCommand(ofxSceneCommand::GOTO_SCENE, now, index));
+}
+
+unsigned int ofxSceneManager::postGotoScene(std::string name, bool now) {
+	ofxSceneCommand c(ofxSceneCommand::GOTO_SCENE_NAME, now);
+	c.name = name;
+	return _commandQueue.post(c);
+}
+
+unsigned int ofxSceneManager::postCommand(const ofxSceneCommand& command) {
+	return _commandQueue.post(command);
+}
+
+bool ofxSceneManager::isCommandApplied(unsigned int ticket) {
+	return _commandQueue.isApplied(ticket);
+}
+
 //--------------------------------------------------------------
 ofxScene* ofxSceneManager::getScene(std::string name) {
 	map<std::string,ofxScene::RunnerScene*>::iterator iter = _scenes.find(name);
@@ -241,22 +381,105 @@ const bool ofxSceneManager::getOverlapingTransitions(){
     return _bOverlapTransitions;
 }
 
+//--------------------------------------------------------------
+void ofxSceneManager::setTransition(ofxSceneTransition* transition) {
+	_endTransition(true);
+	if(_transition != NULL) {
+		delete _transition;
+	}
+	_transition = transition;
+	if(_transition == NULL) {
+		delete _fromFbo;
+		delete _toFbo;
+		_fromFbo = _toFbo = NULL;
+	}
+}
+
+//--------------------------------------------------------------
+void ofxSceneManager::setParallelUpdate(bool parallel) {
+	_bParallelUpdate = parallel;
+	if(_bParallelUpdate && _updateWorker == NULL) {
+		_updateWorker = new ofxSceneUpdateWorker;
+		_updateWorker->startThread(false, false); // non blocking, not verbose
+	}
+	else if(!_bParallelUpdate && _updateWorker != NULL) {
+		_updateWorker->quit();
+		delete _updateWorker;
+		_updateWorker = NULL;
+	}
+}
+
+//--------------------------------------------------------------
+void ofxSceneManager::setCaching(bool caching) {
+	_bCaching = caching;
+	if(!_bCaching) {
+		clearCache();
+	}
+}
+
+void ofxSceneManager::setCacheBudget(unsigned int bytes) {
+	_cacheBudget = bytes;
+	_makeCacheRoom(0);
+}
+
+void ofxSceneManager::clearCache() {
+	std::map<ofxScene::RunnerScene*, CacheEntry>::iterator iter;
+	for(iter = _cache.begin(); iter != _cache.end(); ++iter) {
+		delete iter->second.fbo;
+	}
+	_cache.clear();
+	_cacheMemory = 0;
+}
+
 // ofBaseApp
 //--------------------------------------------------------------
 // need to call ofxScene::RunnerScene::update()
 void ofxSceneManager::update() {
 
+	_updateTransition();
 	_handleSceneChanges();
 
-	// update the current main scene
-	if(!_scenes.empty() && _currentScene >= 0) {
-        ofxScene* s = _currentScenePtr;
-        
-		// call setup if scene is not setup yet
-		if(!s->isSetup()) {
-			_currentRunnerScenePtr->setup();
+	bool current = !_scenes.empty() && _currentScene >= 0;
+	ofxScene::RunnerScene* next = NULL;
+	if((_bOverlapTransitions || _bTransitioning) && !_scenes.empty() &&
+	   _newScene != SCENE_NOCHANGE && _newScene >= 0) {
+		next = _getRunnerSceneAt(_newScene);
+	}
+
+	// call setup if scenes are not setup yet, always on the main thread
+	if(current && !_currentScenePtr->isSetup()) {
+		_currentRunnerScenePtr->setup();
+	}
+	if(next != NULL && !next->scene->isSetup()) {
+		next->setup();
+	}
+
+	// update both scenes at once?
+	if(current && next != NULL && _updateWorker != NULL &&
+	   _currentScenePtr->isThreadSafeUpdate() && next->scene->isThreadSafeUpdate()) {
+
+		_bDeferCommands = true;
+		_updateWorker->update(next);
+		_currentRunnerScenePtr->update();
+		_updateWorker->wait(); // barrier
+		_bDeferCommands = false;
+
+		// if this scene says it's done, go to the next one
+		if(_currentScenePtr->isDone() && !_bSignalledAutoChange) {
+			nextScene();
+			_bSignalledAutoChange = true;
 		}
 
+		// apply transport calls in a fixed order
+		_applyDeferred(_mainCommands);
+		_applyDeferred(_workerCommands);
+		return;
+	}
+
+	// update the current main scene
+	if(current) {
+		ofxScene* s = _currentScenePtr;
+
 		_currentRunnerScenePtr->update();
 
 		// if this scene says it's done, go to the next one
@@ -269,7 +492,7 @@ void ofxSceneManager::update() {
     
 //--------------------- <CAMBIOS MASOTROS> ---------------------//
     // update the new scene, if there is one
-    if(_bOverlapTransitions && !_scenes.empty() && _newScene != SCENE_NOCHANGE && _newScene >= 0){
+    if((_bOverlapTransitions || _bTransitioning) && !_scenes.empty() && _newScene != SCENE_NOCHANGE && _newScene >= 0){
         ofxScene* next_s = getSceneAt(_newScene);
         
         if(!next_s->isSetup()) {
@@ -283,16 +506,39 @@ void ofxSceneManager::update() {
 
 // need to call ofxScene::RunnerScene::draw()
 void ofxSceneManager::draw() {
+	_drawFrame++;
+	if(_bTransitioning) {
+		_drawTransition();
+		_bOffscreenDrawn = false;
+		return;
+	}
 	if(!_scenes.empty() && _currentScene >= 0) {
-		_currentRunnerScenePtr->draw();
+		_drawScene(_currentRunnerScenePtr);
 	}
     
     //--------------------- <CAMBIOS MASOTROS> ---------------------//
     if(_bOverlapTransitions && !_scenes.empty() && _newScene != SCENE_NOCHANGE && _newScene >= 0){
-        _newRunnerScenePtr->draw();
+        _drawScene(_newRunnerScenePtr);
     }
     //--------------------- </CAMBIOS MASOTROS> ---------------------//
     
+	_bOffscreenDrawn = false;
+}
+
+//--------------------------------------------------------------
+void ofxSceneManager::drawOffscreen() {
+	if(_bTransitioning) {
+		_renderTransition();
+	}
+	else {
+		if(!_scenes.empty() && _currentScene >= 0) {
+			_renderCache(_currentRunnerScenePtr);
+		}
+		if(_bOverlapTransitions && !_scenes.empty() && _newScene != SCENE_NOCHANGE && _newScene >= 0) {
+			_renderCache(_newRunnerScenePtr);
+		}
+	}
+	_bOffscreenDrawn = true;
 }
 
 void ofxSceneManager::keyPressed(int key) {
@@ -331,7 +577,7 @@ void ofxSceneManager::mouseReleased(int x, int y, int button) {
 	}
 }
 
-// call resize on all scenes
+// call resize on all scenes, the caches are reallocated on the next draw
 void ofxSceneManager::windowResized(int w, int h) {
 	map<std::string,ofxScene::RunnerScene*>::iterator iter;
 	for(iter = _scenes.begin(); iter != _scenes.end(); ++iter) {
@@ -398,6 +644,7 @@ void ofxSceneManager::gotFocus() {
 }
 
 void ofxSceneManager::gotMemoryWarning() {
+	_assetCache.clearUnused();
 	if(!_scenes.empty() && _currentScene >= 0) {
 		_currentScenePtr->gotMemoryWarning();
 	}
@@ -413,6 +660,13 @@ void ofxSceneManager::deviceOrientationChanged(int newOrientation) {
 }
 #endif
 
+//--------------------------------------------------------------
+bool ofxSceneManager::routeEvent(const ofxInputEvent& event) {
+	if(_currentScenePtr == NULL)
+		return false;
+	return _currentScenePtr->getEventRouter().dispatch(event);
+}
+
 // ofBaseSoundInput
 //--------------------------------------------------------------
 void ofxSceneManager::audioIn(float * input, int bufferSize, int nChannels, int deviceID, long unsigned long tickCount) {
@@ -457,6 +711,15 @@ void ofxSceneManager::audioRequested(float * output, int bufferSize, int nChanne
 //--------------------------------------------------------------
 void ofxSceneManager::_handleSceneChanges() {
 
+	// apply commands posted from other threads, nothing to do if empty
+	if(!_commandQueue.empty()) {
+		ofxSceneCommand command;
+		while(_commandQueue.pop(command)) {
+			_apply(command);
+			_commandQueue.setApplied(command.ticket);
+		}
+	}
+
 	// do the actual main scene change
 	if(_newScene != SCENE_NOCHANGE) {
 	
@@ -519,3 +782,222 @@ ofxScene::RunnerScene* ofxSceneManager::_getRunnerSceneAt(int index) {
 	}
 	return NULL;
 }
+
+//--------------------------------------------------------------
+void ofxSceneManager::_startTransition(ofxScene::RunnerScene* from, ofxScene::RunnerScene* to) {
+	_fromRunner = from;
+	_toRunner = to;
+	if(_fromRunner != NULL) {
+		_fromRunner->setTransition(true, 0);
+	}
+	if(_toRunner != NULL) {
+		_toRunner->setTransition(true, 0);
+	}
+	_transitionProgress = 0;
+	_transitionTimer.set();
+	_bTransitioning = true;
+}
+
+//--------------------------------------------------------------
+void ofxSceneManager::_updateTransition() {
+	if(!_bTransitioning)
+		return;
+
+	float t = 1;
+	if(_transition->getDuration() > 0) {
+		t = (float) _transitionTimer.getDiff() / _transition->getDuration();
+	}
+	_transitionProgress = ofxSceneTransition::ease(_transition->getEasing(), t);
+	if(t >= 1) {
+		_endTransition(true);
+		return;
+	}
+	if(_fromRunner != NULL) {
+		_fromRunner->setTransition(true, _transitionProgress);
+	}
+	if(_toRunner != NULL) {
+		_toRunner->setTransition(true, _transitionProgress);
+	}
+}
+
+//--------------------------------------------------------------
+void ofxSceneManager::_endTransition(bool finish) {
+	if(!_bTransitioning)
+		return;
+	if(_fromRunner != NULL) {
+		_fromRunner->setTransition(false, 1);
+		if(finish) {
+			_fromRunner->scene->finishedExiting();
+		}
+	}
+	if(_toRunner != NULL) {
+		_toRunner->setTransition(false, 1);
+		if(finish) {
+			_toRunner->scene->finishedEntering();
+		}
+	}
+	_fromRunner = _toRunner = NULL;
+	_transitionProgress = 1;
+	_bTransitioning = false;
+}
+
+//--------------------------------------------------------------
+void ofxSceneManager::_renderTransition() {
+	int w = ofGetWidth(), h = ofGetHeight();
+	ofFbo** fbos[2] = {&_fromFbo, &_toFbo};
+	ofxScene::RunnerScene* runners[2] = {_fromRunner, _toRunner};
+	for(int i = 0; i < 2; ++i) {
+		ofFbo*& fbo = *fbos[i];
+		if(fbo == NULL) {
+			fbo = new ofFbo;
+		}
+		if(!fbo->isAllocated() || (int) fbo->getWidth() != w || (int) fbo->getHeight() != h) {
+			fbo->allocate(w, h, GL_RGBA);
+		}
+		ofxBitmapStringBatch::suspend();
+		fbo->begin();
+		ofClear(0, 0, 0, 0);
+		if(runners[i] != NULL) {
+			runners[i]->draw();
+		}
+		fbo->end();
+		ofxBitmapStringBatch::resume();
+	}
+}
+
+//--------------------------------------------------------------
+void ofxSceneManager::_drawTransition() {
+	if(!_bOffscreenDrawn || _fromFbo == NULL || _toFbo == NULL) {
+		_renderTransition();
+	}
+	_transition->composite(_fromFbo->getTextureReference(), _toFbo->getTextureReference(),
+	                       _transitionProgress, ofGetWidth(), ofGetHeight());
+}
+
+//--------------------------------------------------------------
+bool ofxSceneManager::_defer(ofxSceneCommand::Type type, bool value, int index) {
+	if(!_bDeferCommands)
+		return false;
+	ofxSceneCommand c(type, value, index);
+	// each list is only written by one thread & read after the barrier
+	if(_updateWorker->isCurrentThread()) {
+		_workerCommands.push_back(c);
+	}
+	else {
+		_mainCommands.push_back(c);
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+void ofxSceneManager::_applyDeferred(std::vector<ofxSceneCommand>& commands) {
+	for(unsigned int i = 0; i < commands.size(); ++i) {
+		_apply(commands[i]);
+	}
+	commands.clear();
+}
+
+//--------------------------------------------------------------
+void ofxSceneManager::_apply(const ofxSceneCommand& c) {
+	switch(c.type) {
+		case ofxSceneCommand::NO_SCENE:        noScene(c.value); break;
+		case ofxSceneCommand::NEXT_SCENE:      nextScene(c.value); break;
+		case ofxSceneCommand::PREV_SCENE:      prevScene(c.value); break;
+		case ofxSceneCommand::GOTO_SCENE:      gotoScene(c.index, c.value); break;
+		case ofxSceneCommand::GOTO_SCENE_NAME: gotoScene(c.name, c.value); break;
+		case ofxSceneCommand::RUN:             run(c.value); break;
+		case ofxSceneCommand::RUN_TOGGLE:      runToggle(); break;
+	}
+}
+
+//--------------------------------------------------------------
+void ofxSceneManager::_drawScene(ofxScene::RunnerScene* runner) {
+	CacheEntry* entry = _renderCache(runner);
+	if(entry == NULL) {
+		runner->draw();
+		return;
+	}
+	ofPushStyle();
+	ofEnableAlphaBlending();
+	ofSetColor(255);
+	entry->fbo->draw(0, 0);
+	ofPopStyle();
+}
+
+//--------------------------------------------------------------
+ofxSceneManager::CacheEntry* ofxSceneManager::_renderCache(ofxScene::RunnerScene* runner) {
+	ofxScene* s = runner->scene;
+	bool invalidated = runner->checkInvalidated();
+
+	// only cache scenes whose drawing isn't changing every frame
+	bool cacheable = _bCaching && s->isSetup() &&
+		(s->isStatic() || (_bCachePaused && !s->isRunning())) &&
+		!s->isEntering() && !s->isExiting();
+	if(!cacheable) {
+		_releaseCache(runner);
+		return NULL;
+	}
+
+	// (re)allocate if the window size changed
+	int w = ofGetWidth(), h = ofGetHeight();
+	unsigned int bytes = w * h * 4;
+	std::map<ofxScene::RunnerScene*, CacheEntry>::iterator iter = _cache.find(runner);
+	if(iter != _cache.end() &&
+	   ((int) iter->second.fbo->getWidth() != w || (int) iter->second.fbo->getHeight() != h)) {
+		_releaseCache(runner);
+		iter = _cache.end();
+	}
+	if(iter == _cache.end()) {
+		if(!_makeCacheRoom(bytes)) { // too big for the budget
+			return NULL;
+		}
+		CacheEntry entry;
+		entry.fbo = new ofFbo;
+		entry.fbo->allocate(w, h, GL_RGBA);
+		entry.bytes = bytes;
+		entry.bValid = false;
+		iter = _cache.insert(std::make_pair(runner, entry)).first;
+		_cacheMemory += bytes;
+	}
+
+	CacheEntry& entry = iter->second;
+	if(!entry.bValid || invalidated) {
+		ofxBitmapStringBatch::suspend();
+		entry.fbo->begin();
+		ofClear(0, 0, 0, 0);
+		runner->draw();
+		entry.fbo->end();
+		ofxBitmapStringBatch::resume();
+		entry.bValid = true;
+	}
+	entry.lastUsed = _drawFrame;
+	return &entry;
+}
+
+//--------------------------------------------------------------
+void ofxSceneManager::_releaseCache(ofxScene::RunnerScene* runner) {
+	std::map<ofxScene::RunnerScene*, CacheEntry>::iterator iter = _cache.find(runner);
+	if(iter != _cache.end()) {
+		_cacheMemory -= iter->second.bytes;
+		delete iter->second.fbo;
+		_cache.erase(iter);
+	}
+}
+
+//--------------------------------------------------------------
+bool ofxSceneManager::_makeCacheRoom(unsigned int bytes) {
+	if(bytes > _cacheBudget)
+		return false;
+	while(_cacheMemory + bytes > _cacheBudget && !_cache.empty()) {
+		std::map<ofxScene::RunnerScene*, CacheEntry>::iterator iter, oldest = _cache.begin();
+		for(iter = _cache.begin(); iter != _cache.end(); ++iter) {
+			if(iter->second.lastUsed < oldest->second.lastUsed) {
+				oldest = iter;
+			}
+		}
+		ofLogVerbose("ofxSceneManager") << "freeing cache for \""
+			<< oldest->first->scene->getName() << "\", over budget";
+		_releaseCache(oldest->first);
+	}
+	return true;
+}
@@ -11,11 +11,17 @@
 #pragma once
 
 #include <map>
+#include <vector>
 #include <climits>
 
 #include "ofxApp.h"
 #include "ofxScene.h"
 #include "ofxTimer.h"
+#include "ofxSceneTransition.h"
+#include "ofxSceneCommandQueue.h"
+
+class ofFbo;
+class ofxSceneUpdateWorker;
 
 /**
 	\class	SceneManager
@@ -25,7 +31,7 @@ class ofxSceneManager {
 	public:
 
 		ofxSceneManager();
-		virtual ~ofxSceneManager() {}
+		virtual ~ofxSceneManager();
 		
 	/// \section Main
 		
@@ -52,6 +58,9 @@ class ofxSceneManager {
 		void runToggle();
 		bool isRunning(); ///< is the current scene running?
 		
+		/// is a scene change pending or the current scene entering/exiting?
+		bool isTransitioning();
+		
 		/// scene transport
 		void noScene(bool now=false);
 		void nextScene(bool now=false);
@@ -59,6 +68,29 @@ class ofxSceneManager {
 		void gotoScene(unsigned int index, bool now=false);
 		void gotoScene(std::string name, bool now=false);
 		
+	/// \section Thread Safe Scene Control
+		
+		/// post transport commands from any thread, ie OSC or MIDI threads,
+		/// they are applied in order at the start of the next update()
+		///
+		/// returns a ticket to check with isCommandApplied()
+		unsigned int postRun(bool run);
+		unsigned int postRunToggle();
+		unsigned int postNoScene(bool now=false);
+		unsigned int postNextScene(bool now=false);
+		unsigned int postPrevScene(bool now=false);
+		unsigned int postGotoScene(unsigned int index, bool now=false);
+		unsigned int postGotoScene(std::string name, bool now=false);
+		
+		/// post any command, returns its ticket
+		unsigned int postCommand(const ofxSceneCommand& command);
+		
+		/// has a posted command been applied? thread safe
+		///
+		/// note: applied means the transport function was called, the change
+		///       may still be ignored, ie during the min change time
+		bool isCommandApplied(unsigned int ticket);
+		
 		/// scene access
 		/// returns NULL if scene not found
 		ofxScene* getScene(std::string name);
@@ -92,6 +124,66 @@ class ofxSceneManager {
         void setOverlapingTransitions(bool overlap);
         const bool getOverlapingTransitions();
 		
+	/// \section Transitions
+		
+		/// set a transition to run scene changes through, the old & new scenes
+		/// are drawn into fbos & composited by the transition while a single
+		/// clock runs, NULL for the scenes' own updateEnter()/updateExit()
+		/// (default)
+		///
+		/// note: the transition will be destroyed by this object
+		void setTransition(ofxSceneTransition* transition);
+		ofxSceneTransition* getTransition() {return _transition;}
+		
+		/// the eased progress of the running transition, 0-1, 1 if none
+		float getTransitionProgress() {return _transitionProgress;}
+		
+	/// \section Parallel Update
+		
+		/// update the current & new scenes at the same time on 2 threads
+		/// during overlapping transitions when both are thread safe (see
+		/// ofxScene::setThreadSafeUpdate), off by default
+		///
+		/// update() waits for both scenes to finish before returning, then
+		/// checks if the current scene is done & applies any transport calls
+		/// made during the update: the main thread's first, then the worker's
+		void setParallelUpdate(bool parallel);
+		bool getParallelUpdate() {return _bParallelUpdate;}
+		
+	/// \section Draw Caching
+		
+		/// draw cacheable scenes once into an fbo & draw the fbo on the
+		/// following frames instead of redrawing the scene (off by default)
+		///
+		/// static scenes (see ofxScene::setStatic) are always cacheable,
+		/// paused scenes are cacheable if cachePaused is set
+		void setCaching(bool caching);
+		bool getCaching() {return _bCaching;}
+		
+		/// cache scenes paused with run(false)? (on by default)
+		void setCachePaused(bool cache) {_bCachePaused = cache;}
+		bool getCachePaused()           {return _bCachePaused;}
+		
+		/// max memory used by the cached fbos in bytes, the least recently
+		/// drawn caches are freed first when over budget (default 64 MB)
+		void setCacheBudget(unsigned int bytes);
+		unsigned int getCacheBudget() {return _cacheBudget;}
+		
+		/// current memory used by the cached fbos in bytes
+		unsigned int getCacheMemory() {return _cacheMemory;}
+		
+		/// number of scenes currently cached
+		unsigned int getNumCached() {return _cache.size();}
+		
+		/// free all cached fbos
+		void clearCache();
+		
+	/// \section Assets
+		
+		/// the asset cache shared by all scenes, see ofxScene::loadImage(),
+		/// set its memory budget & check its hit/miss & memory stats here
+		ofxSceneAssetCache& getAssetCache() {return _assetCache;}
+		
 	/// \section Current Scene Callbacks
 		
 		/// these are called in the current scene
@@ -100,6 +192,12 @@ class ofxSceneManager {
 		void update();
 		void draw();
 		/// exit() is called automatically on removal/clear
+		
+		/// render the scene cache & transition fbos without drawing them,
+		/// call before draw() when drawing into your own fbo: the following
+		/// draw() only draws the rendered images & doesn't bind any fbos,
+		/// which would unbind yours (ofxSceneCompositor does this)
+		void drawOffscreen();
 
 		void keyPressed(int key);
 		void keyReleased(int key);
@@ -133,6 +231,10 @@ class ofxSceneManager {
 		void deviceOrientationChanged(int newOrientation);
 	#endif
 		
+		/// send an input event to the current scene's event router,
+		/// returns true if the event was consumed
+		bool routeEvent(const ofxInputEvent& event);
+		
 		/// ofBaseSoundInput callbacks
 		void audioIn(float * input, int bufferSize, int nChannels, int deviceID, long unsigned long tickCount);
 		void audioIn(float * input, int bufferSize, int nChannels );
@@ -145,6 +247,14 @@ class ofxSceneManager {
 		
 	private:
 	
+		/// a scene's cached image
+		struct CacheEntry {
+			ofFbo* fbo;            ///< the cached image
+			unsigned int bytes;    ///< fbo memory size
+			unsigned int lastUsed; ///< draw frame the cache was last drawn
+			bool bValid;           ///< is the cached image up to date?
+		};
+	
 		/// handle a pending scene change
 		void _handleSceneChanges();
 		
@@ -153,7 +263,46 @@ class ofxSceneManager {
 		
 		/// wrapper around iter + advance
 		ofxScene::RunnerScene* _getRunnerSceneAt(int index);
-	
+		
+		/// draw a scene, through its cache if possible
+		void _drawScene(ofxScene::RunnerScene* runner);
+		
+		/// update & (re)render a scene's cache if the scene is cacheable,
+		/// returns NULL if it isn't or there is no room in the budget
+		CacheEntry* _renderCache(ofxScene::RunnerScene* runner);
+		
+		/// free a scene's cache, if any
+		void _releaseCache(ofxScene::RunnerScene* runner);
+		
+		/// free the least recently used caches until there is room for
+		/// a number of bytes, returns false if there isn't enough room
+		bool _makeCacheRoom(unsigned int bytes);
+		
+		/// start running the transition between 2 scenes, either may be NULL
+		void _startTransition(ofxScene::RunnerScene* from, ofxScene::RunnerScene* to);
+		
+		/// update the transition clock, ends it when done
+		void _updateTransition();
+		
+		/// stop the transition, finishes entering & exiting if finish is set
+		void _endTransition(bool finish);
+		
+		/// render both scenes into the transition fbos
+		void _renderTransition();
+		
+		/// draw both scenes through the transition
+		void _drawTransition();
+		
+		/// defer a transport call if a parallel update is happening,
+		/// returns true if deferred
+		bool _defer(ofxSceneCommand::Type type, bool value, int index=0);
+		
+		/// apply deferred transport calls in order
+		void _applyDeferred(std::vector<ofxSceneCommand>& commands);
+		
+		/// apply a transport command
+		void _apply(const ofxSceneCommand& command);
+		
 		/// valid scene index value enums
 		enum {
 			SCENE_NOCHANGE = INT_MIN,
@@ -174,4 +323,31 @@ class ofxSceneManager {
 		unsigned int _minChangeTimeMS; ///< minimum ms to wait before accepting scene change commands
 
 		ofxTimer _sceneChangeTimer;    ///< timers to keep track of change times
+		
+		ofxSceneTransition* _transition; ///< transition to use, may be NULL
+		bool _bTransitioning;            ///< is a transition running?
+		float _transitionProgress;       ///< eased transition progress
+		ofxTimer _transitionTimer;       ///< shared transition clock
+		ofxScene::RunnerScene* _fromRunner; ///< transition old scene, may be NULL
+		ofxScene::RunnerScene* _toRunner;   ///< transition new scene, may be NULL
+		ofFbo* _fromFbo;  ///< old scene render target
+		ofFbo* _toFbo;    ///< new scene render target
+		bool _bOffscreenDrawn; ///< fbos rendered by drawOffscreen() this frame?
+		
+		bool _bParallelUpdate;     ///< update scenes in parallel?
+		bool _bDeferCommands;      ///< defer transport calls?
+		ofxSceneUpdateWorker* _updateWorker; ///< parallel update thread
+		std::vector<ofxSceneCommand> _mainCommands;   ///< deferred main thread calls
+		std::vector<ofxSceneCommand> _workerCommands; ///< deferred worker thread calls
+		
+		ofxSceneCommandQueue _commandQueue; ///< commands posted from any thread
+		
+		bool _bCaching;            ///< draw through the cache?
+		bool _bCachePaused;        ///< cache paused scenes?
+		unsigned int _cacheBudget; ///< max cache memory in bytes
+		unsigned int _cacheMemory; ///< current cache memory in bytes
+		unsigned int _drawFrame;   ///< draw counter for the cache LRU
+		std::map<ofxScene::RunnerScene*, CacheEntry> _cache; ///< cached scenes
+		
+		ofxSceneAssetCache _assetCache; ///< assets shared by the scenes
 };
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#include "ofxSceneTransition.h"
+
+#include "ofGraphics.h"
+#include "ofMath.h"
+
+/// SCENE TRANSITION
+
+//--------------------------------------------------------------
+void ofxSceneTransition::composite(ofTexture& from, ofTexture& to, float p, float w, float h) {
+	ofPushStyle();
+	ofEnableAlphaBlending();
+	ofSetColor(255);
+	switch(type) {
+
+		case CROSSFADE:
+		case CUSTOM: // should be overridden, crossfade so neither scene pops
+			from.draw(0, 0, w, h);
+			ofSetColor(255, 255, 255, p * 255);
+			to.draw(0, 0, w, h);
+			break;
+
+		// draw the old scene, then the revealed part of the new scene on top
+		case WIPE_LEFT:
+			from.draw(0, 0, w, h);
+			to.drawSubsection(w * (1-p), 0, w * p, h, w * (1-p), 0);
+			break;
+		case WIPE_RIGHT:
+			from.draw(0, 0, w, h);
+			to.drawSubsection(0, 0, w * p, h, 0, 0);
+			break;
+		case WIPE_UP:
+			from.draw(0, 0, w, h);
+			to.drawSubsection(0, h * (1-p), w, h * p, 0, h * (1-p));
+			break;
+		case WIPE_DOWN:
+			from.draw(0, 0, w, h);
+			to.drawSubsection(0, 0, w, h * p, 0, 0);
+			break;
+
+		// move both scenes
+		case PUSH_LEFT:
+			from.draw(-w * p, 0, w, h);
+			to.draw(w * (1-p), 0, w, h);
+			break;
+		case PUSH_RIGHT:
+			from.draw(w * p, 0, w, h);
+			to.draw(-w * (1-p), 0, w, h);
+			break;
+		case PUSH_UP:
+			from.draw(0, -h * p, w, h);
+			to.draw(0, h * (1-p), w, h);
+			break;
+		case PUSH_DOWN:
+			from.draw(0, h * p, w, h);
+			to.draw(0, -h * (1-p), w, h);
+			break;
+	}
+	ofPopStyle();
+}
+
+//--------------------------------------------------------------
+float ofxSceneTransition::ease(Easing easing, float t) {
+	t = ofClamp(t, 0, 1);
+	switch(easing) {
+		case QUAD_IN:
+			return t * t;
+		case QUAD_OUT:
+			return t * (2 - t);
+		case QUAD_IN_OUT:
+			return t < 0.5f ? 2 * t * t : -1 + (4 - 2 * t) * t;
+		case CUBIC_IN:
+			return t * t * t;
+		case CUBIC_OUT: {
+			float f = t - 1;
+			return f * f * f + 1;
+		}
+		case CUBIC_IN_OUT: {
+			if(t < 0.5f) return 4 * t * t * t;
+			float f = 2 * t - 2;
+			return 0.5f * f * f * f + 1;
+		}
+		case SINE_IN_OUT:
+			return 0.5f * (1 - cosf(t * PI));
+		case LINEAR:
+		default:
+			return t;
+	}
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#pragma once
+
+#include "ofTexture.h"
+
+/**
+	\class  SceneTransition
+	\brief  an easing curve driven transition between two scene images
+
+	set a transition on an ofxSceneManager & it runs scene changes for you:
+	both scenes are updated & drawn into their own fbo while a single clock
+	runs for the duration, then composite() draws the 2 images using the
+	eased progress
+
+	the scenes don't need to fade themselves or call finishedEntering() &
+	finishedExiting(), they can read the progress with
+	ofxScene::getTransitionProgress() if they want to react to it
+
+	subclass & override composite() for a CUSTOM transition, the base class
+	crossfades if it isn't overridden
+**/
+class ofxSceneTransition {
+	public:
+
+		/// transition types
+		enum Type {
+			CROSSFADE,  ///< fade the new scene in over the old one
+			WIPE_LEFT,  ///< reveal the new scene from the right edge moving left
+			WIPE_RIGHT, ///< reveal the new scene from the left edge moving right
+			WIPE_UP,    ///< reveal the new scene from the bottom edge moving up
+			WIPE_DOWN,  ///< reveal the new scene from the top edge moving down
+			PUSH_LEFT,  ///< the new scene pushes the old one out to the left
+			PUSH_RIGHT, ///< the new scene pushes the old one out to the right
+			PUSH_UP,    ///< the new scene pushes the old one out the top
+			PUSH_DOWN,  ///< the new scene pushes the old one out the bottom
+			CUSTOM      ///< subclass & override composite(), crossfades otherwise
+		};
+
+		/// easing curves
+		enum Easing {
+			LINEAR,
+			QUAD_IN,
+			QUAD_OUT,
+			QUAD_IN_OUT,
+			CUBIC_IN,
+			CUBIC_OUT,
+			CUBIC_IN_OUT,
+			SINE_IN_OUT
+		};
+
+		/// duration is in ms
+		ofxSceneTransition(Type type=CROSSFADE, unsigned int duration=1000, Easing easing=LINEAR) :
+			type(type), duration(duration), easing(easing) {}
+		virtual ~ofxSceneTransition() {}
+
+		/// draw the old (from) & new (to) scene images at a size for an eased
+		/// progress between 0 & 1
+		virtual void composite(ofTexture& from, ofTexture& to, float progress, float w, float h);
+
+		/// apply an easing curve to a normalized time between 0 & 1
+		static float ease(Easing easing, float t);
+
+	/// \section Settings
+
+		inline Type getType()      {return type;}
+		void setType(Type t)       {type = t;}
+
+		/// duration in ms
+		inline unsigned int getDuration() {return duration;}
+		void setDuration(unsigned int ms) {duration = ms;}
+
+		inline Easing getEasing()  {return easing;}
+		void setEasing(Easing e)   {easing = e;}
+
+	protected:
+
+		Type type;             ///< transition type
+		unsigned int duration; ///< length in ms
+		Easing easing;         ///< progress easing curve
+};
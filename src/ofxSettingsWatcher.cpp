@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#include "ofxSettingsWatcher.h"
+
+#ifndef OFX_APP_UTILS_NO_XML
+
+#include <sys/stat.h>
+#ifdef TARGET_LINUX
+	#include <sys/inotify.h>
+	#include <poll.h>
+	#include <unistd.h>
+#endif
+
+#include "ofUtils.h"
+#include <ofxXmlSettings.h>
+#include "ofxQuadWarper.h"
+
+/// SETTINGS WATCHER
+
+//--------------------------------------------------------------
+ofxSettingsWatcher::ofxSettingsWatcher() : _pollMS(250) {}
+
+//--------------------------------------------------------------
+ofxSettingsWatcher::~ofxSettingsWatcher() {
+	stop();
+}
+
+//--------------------------------------------------------------
+void ofxSettingsWatcher::setWarpFile(const string xmlFile) {
+	bool running = isWatching();
+	stop();
+	_warpFile = WatchedFile();
+	if(xmlFile != "") {
+		_warpFile.path = ofToDataPath(xmlFile, true);
+		updateStat(_warpFile);
+	}
+	if(running)
+		start();
+}
+
+void ofxSettingsWatcher::setControlFile(const string xmlFile) {
+	bool running = isWatching();
+	stop();
+	_controlFile = WatchedFile();
+	if(xmlFile != "") {
+		_controlFile.path = ofToDataPath(xmlFile, true);
+		updateStat(_controlFile);
+	}
+	if(running)
+		start();
+}
+
+//--------------------------------------------------------------
+void ofxSettingsWatcher::start() {
+	if(isThreadRunning())
+		return;
+	if(_warpFile.path == "" && _controlFile.path == "") {
+		ofLogWarning("ofxSettingsWatcher") << "no files to watch";
+		return;
+	}
+	startThread(true, false); // blocking, not verbose
+}
+
+void ofxSettingsWatcher::stop() {
+	if(!isThreadRunning())
+		return;
+	waitForThread(true); // stop & join
+}
+
+//--------------------------------------------------------------
+bool ofxSettingsWatcher::getWarpChanges(ofVec2f points[4]) {
+	lock();
+	bool changed = _warpFile.bChanged;
+	if(changed) {
+		for(int i = 0; i < 4; ++i) {
+			points[i] = _warpPoints[i];
+		}
+		_warpFile.bChanged = false;
+	}
+	unlock();
+	return changed;
+}
+
+bool ofxSettingsWatcher::getControlChanges(string& xmlFile) {
+	lock();
+	bool changed = _controlFile.bChanged;
+	if(changed) {
+		xmlFile = _controlFile.path;
+		_controlFile.bChanged = false;
+	}
+	unlock();
+	return changed;
+}
+
+/* ***** PROTECTED ***** */
+
+//--------------------------------------------------------------
+void ofxSettingsWatcher::threadedFunction() {
+#ifdef TARGET_LINUX
+	watchFiles();
+#else
+	pollFiles();
+#endif
+}
+
+//--------------------------------------------------------------
+void ofxSettingsWatcher::pollFiles() {
+	while(isThreadRunning()) {
+		if(_warpFile.path != "" && updateStat(_warpFile)) {
+			parseWarpFile();
+		}
+		if(_controlFile.path != "" && updateStat(_controlFile)) {
+			parseControlFile();
+		}
+		sleep(_pollMS);
+	}
+}
+
+#ifdef TARGET_LINUX
+//--------------------------------------------------------------
+// watch the parent dirs instead of the files themselves since most editors
+// save by writing a temp file & moving it over the original
+static string parentDir(const string& path) {
+	size_t slash = path.find_last_of("/");
+	return slash == string::npos ? "." : path.substr(0, slash);
+}
+
+static string fileName(const string& path) {
+	size_t slash = path.find_last_of("/");
+	return slash == string::npos ? path : path.substr(slash+1);
+}
+
+void ofxSettingsWatcher::watchFiles() {
+
+	int fd = inotify_init();
+	if(fd < 0) {
+		ofLogWarning("ofxSettingsWatcher") << "inotify unavailable, polling instead";
+		pollFiles();
+		return;
+	}
+
+	const uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+	int warpWatch = -1, controlWatch = -1;
+	if(_warpFile.path != "") {
+		warpWatch = inotify_add_watch(fd, parentDir(_warpFile.path).c_str(), mask);
+	}
+	if(_controlFile.path != "") {
+		controlWatch = inotify_add_watch(fd, parentDir(_controlFile.path).c_str(), mask);
+	}
+	if((_warpFile.path != "" && warpWatch < 0) ||
+	   (_controlFile.path != "" && controlWatch < 0)) {
+		ofLogWarning("ofxSettingsWatcher") << "could not watch settings dir, polling instead";
+		close(fd);
+		pollFiles();
+		return;
+	}
+
+	string warpName = fileName(_warpFile.path);
+	string controlName = fileName(_controlFile.path);
+
+	// events are variable length, make room for a bunch at once
+	char buffer[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+	struct pollfd pfd = {fd, POLLIN, 0};
+	while(isThreadRunning()) {
+
+		// time out so we notice when the thread is stopped
+		if(poll(&pfd, 1, _pollMS) <= 0)
+			continue;
+
+		ssize_t len = read(fd, buffer, sizeof(buffer));
+		if(len <= 0)
+			continue;
+
+		// coalesce all the events in this read into one parse per file
+		bool warpChanged = false, controlChanged = false;
+		for(char* p = buffer; p < buffer + len;) {
+			struct inotify_event* event = (struct inotify_event*) p;
+			if(event->len > 0) {
+				if(event->wd == warpWatch && warpName == event->name) {
+					warpChanged = true;
+				}
+				if(event->wd == controlWatch && controlName == event->name) {
+					controlChanged = true;
+				}
+			}
+			p += sizeof(struct inotify_event) + event->len;
+		}
+
+		if(warpChanged) {
+			updateStat(_warpFile);
+			parseWarpFile();
+		}
+		if(controlChanged) {
+			updateStat(_controlFile);
+			parseControlFile();
+		}
+	}
+
+	close(fd); // also removes the watches
+}
+#endif
+
+//--------------------------------------------------------------
+bool ofxSettingsWatcher::updateStat(WatchedFile& file) {
+	struct stat info;
+	if(stat(file.path.c_str(), &info) != 0)
+		return false; // missing, maybe mid save
+	bool changed = (info.st_mtime != file.modified || info.st_size != file.size);
+	file.modified = info.st_mtime;
+	file.size = info.st_size;
+	return changed;
+}
+
+//--------------------------------------------------------------
+void ofxSettingsWatcher::parseWarpFile() {
+	ofVec2f points[4];
+	if(!ofxQuadWarper::readSettings(_warpFile.path, points)) {
+		ofLogWarning("ofxSettingsWatcher") << "could not parse \""
+			<< _warpFile.path << "\", ignoring";
+		return;
+	}
+	lock();
+	for(int i = 0; i < 4; ++i) {
+		_warpPoints[i] = points[i];
+	}
+	_warpFile.bChanged = true;
+	unlock();
+	ofLogVerbose("ofxSettingsWatcher") << "reloaded \"" << _warpFile.path << "\"";
+}
+
+// the control panel can only load from a file on the main thread, so make sure
+// the file parses here and hand over the path so a half written file is never
+// applied, note: the control panel parses the file again when loading
+void ofxSettingsWatcher::parseControlFile() {
+	ofxXmlSettings xml;
+	if(!xml.loadFile(_controlFile.path)) {
+		ofLogWarning("ofxSettingsWatcher") << "could not parse \""
+			<< _controlFile.path << "\", ignoring";
+		return;
+	}
+	lock();
+	_controlFile.bChanged = true;
+	unlock();
+	ofLogVerbose("ofxSettingsWatcher") << "reloaded \"" << _controlFile.path << "\"";
+}
+
+#endif
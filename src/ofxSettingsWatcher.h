@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2012 Dan Wilcox <danomatika@gmail.com>
+ *
+ * BSD Simplified License.
+ * For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ * WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ *
+ * See https://github.com/danomatika/ofxAppUtils for documentation
+ *
+ */
+#pragma once
+
+#include "ofConstants.h"
+
+#ifndef OFX_APP_UTILS_NO_XML
+
+#include "ofThread.h"
+#include "ofVectorMath.h"
+
+/**
+	\class  SettingsWatcher
+	\brief  watches the quad warper & control panel settings files for changes
+
+	changed files are parsed on the watcher thread and the results are held
+	until the main thread picks them up, so a running app can be recalibrated
+	by simply overwriting the xml files
+
+	note: the control panel can only load its settings from a file, so its
+	file is only checked on the watcher thread & is parsed again by
+	ofxControlPanel::loadSettings() on the main thread
+
+	uses inotify on Linux & falls back to polling the file modification times
+	on other platforms
+**/
+class ofxSettingsWatcher : public ofThread {
+	public:
+
+		ofxSettingsWatcher();
+		virtual ~ofxSettingsWatcher();
+
+	/// \section Files
+
+		/// set the files to watch, set an empty string to stop watching
+		/// note: paths are relative to the data folder
+		void setWarpFile(const string xmlFile);
+		void setControlFile(const string xmlFile);
+
+		string getWarpFile()    {return _warpFile.path;}
+		string getControlFile() {return _controlFile.path;}
+
+	/// \section Thread Control
+
+		/// start/stop watching
+		void start();
+		void stop();
+		bool isWatching() {return isThreadRunning();}
+
+		/// get/set how often to check the files in ms when polling,
+		/// also the max wait time when stopping the inotify watcher
+		/// (default 250 ms)
+		void setPollInterval(unsigned int ms) {_pollMS = ms;}
+		unsigned int getPollInterval()        {return _pollMS;}
+
+	/// \section Changes
+
+		/// grab newly parsed warp points, returns true and fills points
+		/// if the warp file has changed since the last call
+		///
+		/// note: only takes the lock briefly, call once per frame
+		bool getWarpChanges(ofVec2f points[4]);
+
+		/// returns true and sets xmlFile to the full path if the control
+		/// settings file has changed and parsed cleanly since the last call
+		bool getControlChanges(string& xmlFile);
+
+	protected:
+
+		/// file watch state
+		struct WatchedFile {
+			string path;       ///< full path, empty if unused
+			long modified;     ///< last seen modification time
+			long size;         ///< last seen file size
+			bool bChanged;     ///< pending parsed changes? guarded by the lock
+			WatchedFile() : modified(0), size(0), bChanged(false) {}
+		};
+
+		void threadedFunction();
+
+		/// watcher thread loops
+		void pollFiles();
+	#ifdef TARGET_LINUX
+		void watchFiles();
+	#endif
+
+		/// set the file stat, returns true if the file changed
+		bool updateStat(WatchedFile& file);
+
+		/// parse a changed file on the watcher thread
+		void parseWarpFile();
+		void parseControlFile();
+
+		WatchedFile _warpFile, _controlFile;
+		ofVec2f _warpPoints[4]; ///< parsed warp points waiting to be applied
+		unsigned int _pollMS;   ///< poll interval
+};
+
+#endif